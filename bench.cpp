@@ -0,0 +1,486 @@
+/**
+ * @file bench.cpp
+ * @author Shihong Cong
+ * @brief Benchmarks for every bigint operator across operand sizes, with JSON output and baseline comparison
+ * @version 0.1
+ * @date 2024-12-29
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "bigint.hpp"
+#include "radix_bigint.hpp"
+#include "shared_bigint.hpp"
+
+/**
+ * @brief command line options of the benchmark
+ *
+ */
+struct bench_options
+{
+    size_t max_digits = 10000000;      // largest operand size, in decimal digits
+    size_t steps_per_decade = 1;       // number of sizes between 10^k and 10^(k+1)
+    double min_time = 0.2;             // seconds spent measuring each operation and size
+    double budget = 10.0;              // sizes whose predicted time per operation exceeds this are skipped
+    double threshold = 10.0;           // percent slowdown against the baseline reported as a regression
+    std::vector<std::string> ops;      // operations to run, empty means all
+    std::string json_path;             // where to write the results as JSON, empty means nowhere
+    std::string baseline_path;         // JSON results of an earlier run to compare against
+};
+
+/**
+ * @brief the measurement of one operation at one operand size
+ *
+ */
+struct bench_result
+{
+    std::string operation; // name of the operation
+    size_t digits;         // decimal digits per operand
+    uint64_t iterations;   // number of times the operation ran
+    double ns_per_op;      // average time per operation in nanoseconds
+};
+
+/**
+ * @brief the operands of one operation at one operand size
+ *
+ */
+struct bench_operands
+{
+    std::string a_str; // decimal string of a
+    std::string a_hex; // hexadecimal string of a
+    int64_t a_int;     // a as an int64_t, when it fits
+    bigint a;          // a random number with the requested number of digits
+    bigint b;          // a random number with the same number of digits, smaller than a
+    bigint c;          // a copy of a that differs only in the least significant digit
+    decimal_bigint d;  // a stored in base 10^19
+    shared_bigint s;   // a shared copy-on-write
+    bigint ab;         // a * b + c, a dividend twice as long as b
+};
+
+/**
+ * @brief a benchmarked operation
+ *
+ */
+struct bench_operation
+{
+    std::string name;                               // name of the operation
+    size_t max_digits;                              // largest meaningful operand size
+    std::function<void(bench_operands &)> run_once; // the operation itself
+};
+
+volatile size_t sink = 0; // consumes results so that the optimizer keeps the operations
+
+/**
+ * @brief generate a random number with exactly the given number of digits, from a fixed seed
+ *
+ * @param digits the number of decimal digits
+ * @param rng the random number generator
+ * @return std::string the decimal string
+ */
+std::string random_digits(size_t digits, std::mt19937_64 &rng)
+{
+    std::uniform_int_distribution<int> digit(0, 9);
+    std::uniform_int_distribution<int> leading(1, 9);
+    std::string str(digits, '0');
+    str[0] = char('0' + leading(rng));
+    for (size_t i = 1; i < digits; i++)
+    {
+        str[i] = char('0' + digit(rng));
+    }
+    return str;
+}
+
+/**
+ * @brief prepare the operands for one operand size
+ *
+ * @param digits the number of decimal digits
+ * @return bench_operands the operands
+ */
+bench_operands make_operands(size_t digits)
+{
+    std::mt19937_64 rng(digits); // fixed seed so that runs are comparable
+    bench_operands operands;
+    operands.a_str = random_digits(digits, rng);
+    std::string b_str = random_digits(digits, rng);
+    if (b_str > operands.a_str)
+    {
+        std::swap(b_str, operands.a_str);
+    }
+    std::string c_str = operands.a_str;
+    c_str.back() = (c_str.back() == '9') ? '8' : char(c_str.back() + 1);
+
+    operands.a_int = digits <= 18 ? std::stoll(operands.a_str) : 0;
+    operands.a = bigint(operands.a_str);
+    operands.a_hex = operands.a.to_string(16);
+    operands.b = bigint(b_str);
+    operands.c = bigint(c_str);
+    operands.d = decimal_bigint(operands.a_str);
+    operands.s = shared_bigint(operands.a);
+    operands.ab = operands.a * operands.b + operands.c;
+    return operands;
+}
+
+/**
+ * @brief the benchmarked operations
+ *
+ * @return std::vector<bench_operation> every operation with its largest meaningful size
+ */
+std::vector<bench_operation> make_operations()
+{
+    std::vector<bench_operation> operations;
+    operations.push_back({"construct", 18, [](bench_operands &o)
+                          { sink = sink + (bigint(o.a_int) == o.b); }});
+    operations.push_back({"parse", SIZE_MAX, [](bench_operands &o)
+                          { sink = sink + (bigint(o.a_str) == o.b); }});
+    operations.push_back({"print", SIZE_MAX, [](bench_operands &o)
+                          {
+                              std::ostringstream os;
+                              os << o.a;
+                              sink = sink + os.str().size();
+                          }});
+    operations.push_back({"parse_hex", SIZE_MAX, [](bench_operands &o)
+                          { sink = sink + (bigint::from_hex(o.a_hex) == o.b); }});
+    operations.push_back({"print_hex", SIZE_MAX, [](bench_operands &o)
+                          { sink = sink + o.a.to_string(16).size(); }});
+    operations.push_back({"parse_decimal", SIZE_MAX, [](bench_operands &o)
+                          { sink = sink + (decimal_bigint(o.a_str) == o.d); }});
+    operations.push_back({"print_decimal", SIZE_MAX, [](bench_operands &o)
+                          {
+                              std::ostringstream os;
+                              os << o.d;
+                              sink = sink + os.str().size();
+                          }});
+    operations.push_back({"add", SIZE_MAX, [](bench_operands &o)
+                          { sink = sink + (o.a + o.b == o.c); }});
+    operations.push_back({"subtract", SIZE_MAX, [](bench_operands &o)
+                          { sink = sink + (o.a - o.b == o.c); }});
+    operations.push_back({"multiply", SIZE_MAX, [](bench_operands &o)
+                          { sink = sink + (o.a * o.b == o.c); }});
+    operations.push_back({"fma", SIZE_MAX, [](bench_operands &o)
+                          {
+                              bigint acc = o.c;
+                              fma(acc, o.a, o.b);
+                              sink = sink + (acc == o.c);
+                          }});
+    operations.push_back({"divide", SIZE_MAX, [](bench_operands &o)
+                          { sink = sink + (o.ab / o.b == o.a); }});
+    operations.push_back({"gcd", 100000, [](bench_operands &o)
+                          { sink = sink + (gcd(o.ab, o.a) == o.b); }});
+    operations.push_back({"copy", SIZE_MAX, [](bench_operands &o)
+                          {
+                              bigint copy = o.a;
+                              sink = sink + bigint_view(copy).size();
+                          }});
+    operations.push_back({"copy_shared", SIZE_MAX, [](bench_operands &o)
+                          {
+                              shared_bigint copy = o.s;
+                              sink = sink + bigint_view(copy).size();
+                          }});
+    operations.push_back({"compare", SIZE_MAX, [](bench_operands &o)
+                          { sink = sink + (o.a < o.c); }});
+    operations.push_back({"increment", SIZE_MAX, [](bench_operands &o)
+                          { sink = sink + (++o.b == o.a); }});
+    operations.push_back({"scale", SIZE_MAX, [](bench_operands &o)
+                          { sink = sink + (o.a * 7 == o.c); }});
+    operations.push_back({"divide_small", SIZE_MAX, [](bench_operands &o)
+                          { sink = sink + (o.a / 7 == o.c); }});
+    return operations;
+}
+
+/**
+ * @brief run an operation in batches of doubling size until min_time has passed
+ *
+ * @param operation the operation to run
+ * @param operands its operands
+ * @param min_time the minimum time to measure, in seconds
+ * @param iterations set to the total number of runs
+ * @return double the average time per operation in nanoseconds
+ */
+double measure(const bench_operation &operation, bench_operands &operands, double min_time, uint64_t &iterations)
+{
+    using clock = std::chrono::steady_clock;
+    iterations = 0;
+    uint64_t batch = 1;
+    double elapsed = 0;
+    auto start = clock::now();
+    while (elapsed < min_time)
+    {
+        for (uint64_t i = 0; i < batch; i++)
+        {
+            operation.run_once(operands);
+        }
+        iterations += batch;
+        batch *= 2;
+        elapsed = std::chrono::duration<double>(clock::now() - start).count();
+    }
+    return elapsed * 1e9 / double(iterations);
+}
+
+/**
+ * @brief the operand sizes from 1 digit to max_digits, evenly spaced on a log scale
+ *
+ * @param options the command line options
+ * @return std::vector<size_t> the sizes in increasing order
+ */
+std::vector<size_t> make_sizes(const bench_options &options)
+{
+    std::vector<size_t> sizes;
+    for (size_t step = 0;; step++)
+    {
+        double exponent = double(step) / double(options.steps_per_decade);
+        size_t digits = size_t(std::llround(std::pow(10.0, exponent)));
+        if (digits > options.max_digits)
+        {
+            break;
+        }
+        if (sizes.empty() || digits != sizes.back())
+        {
+            sizes.push_back(digits);
+        }
+    }
+    return sizes;
+}
+
+/**
+ * @brief read the results of an earlier run written by write_json
+ *
+ * @param path the JSON file
+ * @return std::map<std::pair<std::string, size_t>, double> ns_per_op by operation and size
+ */
+std::map<std::pair<std::string, size_t>, double> read_baseline(const std::string &path)
+{
+    std::ifstream file(path);
+    if (!file)
+    {
+        throw std::invalid_argument("Cannot open baseline: " + path);
+    }
+
+    // every result is written on its own line, so a line-by-line scan is enough
+    auto field = [](const std::string &line, const std::string &key) -> std::string
+    {
+        size_t pos = line.find("\"" + key + "\":");
+        if (pos == std::string::npos)
+        {
+            return "";
+        }
+        pos += key.size() + 3;
+        size_t end = line.find_first_of(",}", pos);
+        std::string value = line.substr(pos, end - pos);
+        value.erase(0, value.find_first_not_of(" \""));
+        value.erase(value.find_last_not_of(" \"") + 1);
+        return value;
+    };
+
+    std::map<std::pair<std::string, size_t>, double> baseline;
+    std::string line;
+    while (std::getline(file, line))
+    {
+        std::string operation = field(line, "operation");
+        if (!operation.empty())
+        {
+            baseline[{operation, std::stoull(field(line, "digits"))}] = std::stod(field(line, "ns_per_op"));
+        }
+    }
+    return baseline;
+}
+
+/**
+ * @brief write the results as JSON, one result per line
+ *
+ * @param path the JSON file
+ * @param results the measurements
+ */
+void write_json(const std::string &path, const std::vector<bench_result> &results)
+{
+    std::ofstream file(path);
+    if (!file)
+    {
+        throw std::invalid_argument("Cannot open output: " + path);
+    }
+
+    file << "{\n  \"benchmark\": \"bigint\",\n  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        const bench_result &r = results[i];
+        file << "    {\"operation\": \"" << r.operation << "\", \"digits\": " << r.digits
+             << ", \"iterations\": " << r.iterations << std::setprecision(6)
+             << ", \"ns_per_op\": " << r.ns_per_op
+             << ", \"ops_per_second\": " << 1e9 / r.ns_per_op
+             << ", \"digits_per_second\": " << 1e9 * double(r.digits) / r.ns_per_op << "}"
+             << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    file << "  ]\n}\n";
+}
+
+/**
+ * @brief parse the command line
+ *
+ * @param argc number of arguments
+ * @param argv the arguments
+ * @return bench_options the options
+ */
+bench_options parse_options(int argc, char *argv[])
+{
+    bench_options options;
+    std::vector<std::string> args(argv + 1, argv + argc);
+    for (size_t i = 0; i < args.size(); i++)
+    {
+        auto value = [&]() -> const std::string &
+        {
+            if (i + 1 >= args.size())
+            {
+                throw std::invalid_argument("Missing value for " + args[i]);
+            }
+            return args[++i];
+        };
+
+        if (args[i] == "--max-digits")
+        {
+            options.max_digits = std::stoull(value());
+        }
+        else if (args[i] == "--steps-per-decade")
+        {
+            options.steps_per_decade = std::max<size_t>(1, std::stoull(value()));
+        }
+        else if (args[i] == "--min-time")
+        {
+            options.min_time = std::stod(value());
+        }
+        else if (args[i] == "--budget")
+        {
+            options.budget = std::stod(value());
+        }
+        else if (args[i] == "--threshold")
+        {
+            options.threshold = std::stod(value());
+        }
+        else if (args[i] == "--ops")
+        {
+            std::stringstream list(value());
+            std::string op;
+            while (std::getline(list, op, ','))
+            {
+                options.ops.push_back(op);
+            }
+        }
+        else if (args[i] == "--json")
+        {
+            options.json_path = value();
+        }
+        else if (args[i] == "--baseline")
+        {
+            options.baseline_path = value();
+        }
+        else
+        {
+            throw std::invalid_argument("Unknown option: " + args[i] +
+                                        "\nUsage: bench [--max-digits N] [--steps-per-decade K] [--min-time S] [--budget S]"
+                                        " [--ops op1,op2] [--json FILE] [--baseline FILE] [--threshold PCT]");
+        }
+    }
+    return options;
+}
+
+int main(int argc, char *argv[])
+{
+    bench_options options;
+    std::map<std::pair<std::string, size_t>, double> baseline;
+    try
+    {
+        options = parse_options(argc, argv);
+        if (!options.baseline_path.empty())
+        {
+            baseline = read_baseline(options.baseline_path);
+        }
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 2;
+    }
+
+    std::vector<size_t> sizes = make_sizes(options);
+    std::vector<bench_result> results;
+    size_t regressions = 0;
+
+    std::cout << std::left << std::setw(10) << "operation" << std::right << std::setw(10) << "digits"
+              << std::setw(12) << "iterations" << std::setw(16) << "ns/op" << std::setw(14) << "ops/s"
+              << std::setw(16) << "Mdigits/s" << std::setw(12) << "vs base" << std::endl;
+
+    for (const bench_operation &operation : make_operations())
+    {
+        if (!options.ops.empty() && std::find(options.ops.begin(), options.ops.end(), operation.name) == options.ops.end())
+        {
+            continue;
+        }
+
+        double previous = 0; // ns/op at the previous size, used to predict the next one
+        double current = 0;
+        for (size_t digits : sizes)
+        {
+            if (digits > operation.max_digits)
+            {
+                break;
+            }
+
+            // skip sizes that would take too long, assuming the growth seen between the last two sizes continues
+            if (previous > 0 && current * (current / previous) > options.budget * 1e9)
+            {
+                std::cout << std::left << std::setw(10) << operation.name << std::right << std::setw(10) << digits
+                          << "  skipped, predicted time per operation exceeds the budget" << std::endl;
+                break;
+            }
+
+            bench_operands operands = make_operands(digits);
+            bench_result r{operation.name, digits, 0, 0};
+            r.ns_per_op = measure(operation, operands, options.min_time, r.iterations);
+            results.push_back(r);
+            previous = current;
+            current = r.ns_per_op;
+
+            std::cout << std::left << std::setw(10) << r.operation << std::right << std::setw(10) << r.digits
+                      << std::setw(12) << r.iterations << std::fixed << std::setprecision(1)
+                      << std::setw(16) << r.ns_per_op << std::setw(14) << 1e9 / r.ns_per_op
+                      << std::setw(16) << std::setprecision(3) << 1e3 * double(r.digits) / r.ns_per_op;
+
+            auto base = baseline.find({r.operation, r.digits});
+            if (base != baseline.end())
+            {
+                double change = 100.0 * (r.ns_per_op - base->second) / base->second;
+                std::cout << std::setw(11) << std::setprecision(1) << std::showpos << change << "%" << std::noshowpos;
+                if (change > options.threshold)
+                {
+                    std::cout << "  REGRESSION";
+                    regressions++;
+                }
+            }
+            std::cout << std::defaultfloat << std::endl;
+        }
+    }
+
+    if (!options.json_path.empty())
+    {
+        write_json(options.json_path, results);
+    }
+
+    if (!baseline.empty())
+    {
+        std::cout << regressions << " regression(s) slower than the baseline by more than "
+                  << std::setprecision(6) << options.threshold << "%" << std::endl;
+    }
+
+    return regressions == 0 ? 0 : 1;
+}
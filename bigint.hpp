@@ -8,31 +8,150 @@
  * @copyright Copyright (c) 2024
  *
  */
+#pragma once
+
 #include <vector>
 #include <iostream>
+#include <span>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include "bigint_kernels.hpp"
+#include "bigint_mpn.hpp"
+#include "bigint_scratch.hpp"
+#include "bigint_stats.hpp"
+#include "bigint_thresholds.hpp"
+
+class bigint;
+
+/**
+ * @brief the native integer types accepted by the single-limb fast paths
+ *
+ * @tparam T an integer type other than bool
+ */
+template <typename T>
+concept bigint_native_integer = std::integral<T> && !std::same_as<T, bool>;
+
+/**
+ * @brief A non-owning, read-only view of an integer: a sign plus a span of limbs
+ *
+ * A view can refer to a whole bigint, to a sub-range of its limbs, or to limbs stored
+ * anywhere else, and can be passed to every arithmetic and comparison operator without
+ * constructing a bigint. The viewed limbs must outlive the view.
+ */
+class bigint_view
+{
+public:
+    // Constructors
+    bigint_view();                                           // view of zero
+    bigint_view(std::span<const bigint_limb>, bool = false); // view of little endian limbs stored elsewhere
+    bigint_view(const bigint &);                             // view of a whole bigint
+
+    // access
+    std::span<const bigint_limb> limbs() const; // little endian
+    bool negative() const;                      // true if negative, false if positive
+    size_t size() const;                        // number of limbs, including leading zeros
+    bigint_limb operator[](size_t) const;       // limb at a position
+    bool is_zero() const;                       // true if every limb is zero
+
+    // bits of the absolute value
+    size_t bit_length() const;  // number of bits, 0 for zero
+    size_t popcount() const;    // number of set bits
+    size_t countr_zero() const; // number of trailing zero bits, 0 for zero
+
+    // slicing
+    bigint_view subview(size_t, size_t) const; // non-negative view of a range of limbs
+    bigint_view abs() const;                   // view with the sign dropped
+    bigint_view operator-() const;             // view with the sign flipped
+    bigint_view trimmed() const;               // view without leading zeros
+
+private:
+    std::span<const bigint_limb> span; // little endian
+    bool is_negative;                  // true if negative, false if positive
+};
 
 class bigint
 {
 public:
     // Constructors
-    bigint();                    // default constructor
-    bigint(int64_t);             // constructor for processing int64_t
-    bigint(const std::string &); // constructor for processing string
+    bigint();                     // default constructor
+    bigint(int64_t);              // constructor for processing int64_t
+    bigint(const std::string &);  // constructor for processing string
+    explicit bigint(bigint_view); // constructor for copying a view
+
+    // conversion in other radices
+    static bigint from_string(std::string_view, unsigned); // digits in radix 10 or a power of two up to 32
+    static bigint from_hex(std::string_view);              // hexadecimal digits in either case
+    std::string to_string(unsigned = 10) const;            // digits in radix 10 or a power of two up to 32, lowercase
 
     // Operators
     // subtraction
-    bigint operator-(const bigint &);  // subtraction
-    bigint operator-=(const bigint &); // subtraction assignment
+    bigint operator-(const bigint &) const; // subtraction
+    bigint operator-=(const bigint &);      // subtraction assignment
+    bigint operator-=(bigint_view);         // subtraction assignment of a view
     // addition
-    bigint operator+(const bigint &);  // addition
-    bigint operator+=(const bigint &); // addition assignment
+    bigint operator+(const bigint &) const; // addition
+    bigint operator+=(const bigint &);      // addition assignment
+    bigint operator+=(bigint_view);         // addition assignment of a view
 
     // multiplication
-    bigint operator*(const bigint &);  // multiplication
-    bigint operator*=(const bigint &); // multiplication assignment
+    bigint operator*(const bigint &) const; // multiplication
+    bigint operator*=(const bigint &);      // multiplication assignment
+    bigint operator*=(bigint_view);         // multiplication assignment of a view
+
+    // native integer operands, one pass over the limbs without converting the operand to bigint
+    template <bigint_native_integer T>
+    bigint operator+(T) const; // addition
+    template <bigint_native_integer T>
+    bigint operator+=(T); // addition assignment, stops as soon as the carry dies out
+    template <bigint_native_integer T>
+    bigint operator-(T) const; // subtraction
+    template <bigint_native_integer T>
+    bigint operator-=(T); // subtraction assignment, stops as soon as the borrow dies out
+    template <bigint_native_integer T>
+    bigint operator*(T) const; // multiplication
+    template <bigint_native_integer T>
+    bigint operator*=(T); // multiplication assignment
+    template <bigint_native_integer T>
+    bigint operator/(T) const; // division truncating towards zero
+    template <bigint_native_integer T>
+    bigint operator/=(T); // division assignment
+    template <bigint_native_integer T>
+    bigint operator%(T) const; // remainder with the sign of the dividend
+    template <bigint_native_integer T>
+    bigint operator%=(T); // remainder assignment
+    bigint operator/=(bigint_view); // division assignment by a view, truncating towards zero
+    bigint operator%=(bigint_view); // remainder assignment by a view, with the sign of the dividend
 
     // negation
-    bigint operator-(); // unary negation
+    bigint operator-() const; // unary negation
+
+    // bitwise, negative numbers behave as infinite two's complement
+    bigint operator&(const bigint &) const; // bitwise and
+    bigint operator&=(const bigint &);      // bitwise and assignment
+    bigint operator|(const bigint &) const; // bitwise or
+    bigint operator|=(const bigint &);      // bitwise or assignment
+    bigint operator^(const bigint &) const; // bitwise xor
+    bigint operator^=(const bigint &);      // bitwise xor assignment
+    bigint operator~() const;               // bitwise not, ~x = -x - 1
+
+    // shifts
+    bigint operator<<(size_t) const; // multiplication by 2^k
+    bigint operator<<=(size_t);      // left shift assignment
+    bigint operator>>(size_t) const; // division by 2^k rounding towards negative infinity
+    bigint operator>>=(size_t);      // right shift assignment
+
+    // bits of the absolute value
+    size_t bit_length() const;  // number of bits, 0 for zero
+    size_t popcount() const;    // number of set bits
+    size_t countr_zero() const; // number of trailing zero bits, 0 for zero
 
     // comparison
     bool operator==(const bigint &) const; // equal to
@@ -53,24 +172,113 @@ public:
     bigint operator++(int); // post-increment
     bigint operator--(int); // post-decrement
 
+    // operators on views
+    friend bigint operator+(bigint_view, bigint_view);
+    friend bigint operator-(bigint_view, bigint_view);
+    friend bigint operator*(bigint_view, bigint_view);
+    friend std::pair<bigint, bigint> divmod(bigint_view, bigint_view);
+    friend bigint gcd(bigint_view, bigint_view);
+    friend bigint pow(bigint_view, uint64_t);
+    friend void fma(bigint &, bigint_view, bigint_view);
+    friend void fms(bigint &, bigint_view, bigint_view);
+    friend bigint operator&(bigint_view, bigint_view);
+    friend bigint operator|(bigint_view, bigint_view);
+    friend bigint operator^(bigint_view, bigint_view);
+    friend bigint operator~(bigint_view);
+    friend bigint operator<<(bigint_view, size_t);
+    friend bigint operator>>(bigint_view, size_t);
+    friend bool operator==(bigint_view, bigint_view);
+    friend bool operator<(bigint_view, bigint_view);
+
+    friend class bigint_view;
+    friend class bigint_column;
+
 private:
-    std::vector<int8_t> digits; // little endian
-    bool is_negative;           // true if negative, false if positive
+    using limb_vector = std::vector<bigint_limb, bigint_allocator<bigint_limb>>;
+
+    limb_vector limbs; // little endian, base 2^64, no leading zero limbs, empty for zero
+    bool is_negative;  // true if negative, false if positive or zero
 
     // helper functions + variables
-    bigint negate(const bigint &) const;                   // negate a bigint
-    bigint add(const bigint &, const bigint &);            // addition logic for two positive numbers
-    bigint subtract(const bigint &, const bigint &);       // subtraction logic for num1 > num2
-    bool is_smaller(const bigint &, const bigint &) const; // compare two bigints
+    static bigint signed_add(bigint_view, bigint_view);        // addition logic for two signed numbers
+    static bigint add(bigint_view, bigint_view);               // addition logic for two positive numbers
+    static bigint subtract(bigint_view, bigint_view);          // subtraction logic for num1 > num2
+    static bigint square(bigint_view);                         // multiplication of a number by itself
+    static void mul_limbs(bigint_limb *, const bigint_limb *, size_t, const bigint_limb *, size_t); // out = a * b, Karatsuba above the threshold
+    static void sqr_limbs(bigint_limb *, const bigint_limb *, size_t); // out = a * a, Karatsuba above the threshold
+    static void divmod_magnitudes(bigint &, bigint &, bigint_view, bigint_view); // quotient and remainder of two magnitudes
+    static void div_limbs(bigint_limb *, bigint_limb *, size_t, const bigint_limb *, size_t); // q = u / d, u becomes u mod d
+    static bigint_limb div_normalised(bigint_limb *, bigint_limb *, size_t, const bigint_limb *, size_t); // div_limbs for a divisor with its top bit set
+    static bigint_limb div_basecase(bigint_limb *, bigint_limb *, size_t, const bigint_limb *, size_t); // long division, Knuth's algorithm D
+    static bigint_limb div_2n_1n(bigint_limb *, bigint_limb *, const bigint_limb *, size_t); // 2n-limb by n-limb recursive division
+    static int radix_bits(unsigned);             // bits per digit of a power-of-two radix
+    static constexpr size_t decimal_chunk_digits = 19; // decimal digits per limb-sized chunk
+    static size_t parse_decimal(const char *, size_t, bigint_limb *); // decimal digits to limbs, chunked or divide and conquer
+    static size_t parse_chunks(const char *, size_t, bigint_limb *);  // decimal digits to limbs, 19 at a time
+    static size_t decimal_levels(size_t);                             // levels of divide-and-conquer conversion for a number of digits
+    static const std::vector<bigint> &decimal_powers(size_t);         // 10^(19 * 2^k) for divide-and-conquer conversion, cached per thread
+    static size_t parse_recursive(const char *, size_t, const std::vector<bigint> &, bigint_limb *); // divide-and-conquer parsing
+    static void format_chunks(bigint_limb *, size_t, size_t, char *); // zero-padded digits, 19 at a time
+    static void format_recursive(bigint_limb *, size_t, const std::vector<bigint> &, size_t, char *); // divide-and-conquer printing
+    static void append_decimal(bigint_view, std::string &);           // decimal digits of a number, appended
+    static void multiply_accumulate(bigint &, bigint_view, bigint_view, bool);          // acc += a * b, or acc -= a * b
+    static bool is_smaller(bigint_view, bigint_view);          // compare two signed numbers
+    static int compare_magnitude(bigint_view, bigint_view);    // compare the absolute values of two numbers
+    static limb_vector to_twos_complement(bigint_view, size_t); // sign extended two's complement limbs
+    static bigint from_twos_complement(limb_vector);            // inverse of to_twos_complement
+    template <typename Op>
+    static bigint bitwise(bigint_view, bigint_view, Op); // apply a limb operation in two's complement
+    void trim();                                         // remove leading zero limbs, zero is never negative
+    bigint_limb multiply_add_small(bigint_limb, bigint_limb); // *this = *this * m + a for positive *this
+    bigint_limb divide_small(bigint_limb);                    // *this /= d for positive *this, returns remainder
+    bigint_limb remainder_small(bigint_limb) const;           // |*this| % d
+    void add_small(bigint_limb, bool);                        // *this += m with m given as magnitude and sign
+    void multiply_small(bigint_limb, bool);                   // *this *= m with m given as magnitude and sign
+    bigint_limb divmod_small(bigint_limb, bool);              // *this /= m truncating, returns |remainder|
+    template <bigint_native_integer T>
+    static bigint_limb native_magnitude(T); // absolute value of a native integer
+    template <bigint_native_integer T>
+    static bool native_negative(T); // true if a native integer is negative
 };
 
+// operators on views, bigint converts to bigint_view implicitly
+bigint operator+(bigint_view, bigint_view);   // addition
+bigint operator-(bigint_view, bigint_view);   // subtraction
+bigint operator*(bigint_view, bigint_view);   // multiplication
+bigint operator/(bigint_view, bigint_view);   // division truncating towards zero
+bigint operator%(bigint_view, bigint_view);   // remainder with the sign of the dividend
+std::pair<bigint, bigint> divmod(bigint_view, bigint_view); // quotient and remainder together
+bigint gcd(bigint_view, bigint_view);         // greatest common divisor
+bigint pow(bigint_view, uint64_t);            // exponentiation
+void fma(bigint &, bigint_view, bigint_view); // acc += a * b without a temporary product
+void fms(bigint &, bigint_view, bigint_view); // acc -= a * b without a temporary product
+bigint operator&(bigint_view, bigint_view);   // bitwise and
+bigint operator|(bigint_view, bigint_view);   // bitwise or
+bigint operator^(bigint_view, bigint_view);   // bitwise xor
+bigint operator~(bigint_view);                // bitwise not
+bigint operator<<(bigint_view, size_t);       // left shift
+bigint operator>>(bigint_view, size_t);       // right shift
+bool operator==(bigint_view, bigint_view);    // equal to
+bool operator!=(bigint_view, bigint_view);    // not equal to
+bool operator<(bigint_view, bigint_view);     // less than
+bool operator<=(bigint_view, bigint_view);    // less than or equal to
+bool operator>(bigint_view, bigint_view);     // greater than
+bool operator>=(bigint_view, bigint_view);    // greater than or equal to
+
+// native integers on the left
+template <bigint_native_integer T>
+bigint operator+(T, const bigint &); // addition
+template <bigint_native_integer T>
+bigint operator-(T, const bigint &); // subtraction
+template <bigint_native_integer T>
+bigint operator*(T, const bigint &); // multiplication
+
 /**
  * @brief Construct a new bigint::bigint object with empty value
  *
  */
 bigint::bigint()
 {
-    digits.push_back(0);
     is_negative = false;
 }
 
@@ -81,510 +289,2433 @@ bigint::bigint()
  */
 bigint::bigint(int64_t val)
 {
+    BIGINT_COUNT_OP(bigint_op::construct);
     is_negative = (val < 0);
-    val = std::abs(val);
 
-    if (val == 0)
-    {
-        bigint();
-        return;
-    }
-    else
+    // negate in unsigned arithmetic so that INT64_MIN does not overflow
+    bigint_limb magnitude = is_negative ? 0 - bigint_limb(val) : bigint_limb(val);
+    if (magnitude != 0)
     {
-        while (val > 0)
-        {
-            digits.push_back((int8_t)(val % 10)); // retrieve the last digit
-            val /= 10;                            // remove the last digit
-        }
+        limbs.push_back(magnitude);
     }
 }
 
 /**
  * @brief Construct a new bigint object
  *
+ * The digits are validated in one word-parallel pass, then converted in chunks of 19 digits,
+ * or by divide and conquer from bigint_active_thresholds.recursive_conversion limbs.
+ *
  * @param str a string value to be converted to bigint
  */
 bigint::bigint(const std::string &str)
 {
+    BIGINT_COUNT_OP(bigint_op::parse);
     if (str.empty())
     {
         throw std::invalid_argument("Input String is Empty");
     }
 
-    if (str == "0")
+    is_negative = (str[0] == '-');
+    size_t first = is_negative ? 1 : 0;
+    if (first == str.size())
     {
-        bigint();
-        return;
+        throw std::invalid_argument("Invalid argument: " + str);
     }
 
-    is_negative = (str[0] == '-');
-
-    for (int64_t i = (int64_t)str.size() - 1; i >= 0; i--)
+    if (!bigint_active_kernels.all_digits(str.data() + first, str.size() - first))
     {
-        if (str[(size_t)i] == '-' && i == 0)
-        {
-            continue;
-        }
-
-        if (str[(size_t)i] < '0' || str[(size_t)i] > '9')
-        {
-            throw std::invalid_argument("Invalid argument: " + str);
-        }
-        digits.push_back(str[(size_t)i] - '0'); // convert char to int
+        throw std::invalid_argument("Invalid argument: " + str);
     }
+
+    size_t digits = str.size() - first;
+    limbs.resize(digits / decimal_chunk_digits + 1);
+    limbs.resize(parse_decimal(str.data() + first, digits, limbs.data()));
+    trim();
 }
 
 /**
- * @brief a helper function to negate of a bigint
+ * @brief a helper function to convert validated decimal digits to limbs
  *
- * @param num a bigint to be negated
- * @return bigint the negated bigint
+ * The digits are converted in chunks of 19 below bigint_active_thresholds.recursive_conversion
+ * limbs, and by divide and conquer above it.
+ *
+ * @param str validated decimal digits, the most significant first
+ * @param n the number of digits
+ * @param out room for n / 19 + 1 limbs
+ * @return size_t the number of limbs written, without leading zeros
  */
-bigint bigint::negate(const bigint &num) const
+size_t bigint::parse_decimal(const char *str, size_t n, bigint_limb *out)
 {
-    bigint result = num;
-    result.is_negative = !result.is_negative;
-    return result;
+    if (n < bigint_threshold(&bigint_thresholds::recursive_conversion) * decimal_chunk_digits)
+    {
+        return parse_chunks(str, n, out);
+    }
+    BIGINT_COUNT_ALGORITHM(bigint_algorithm::dec_recursive, n / decimal_chunk_digits);
+    return parse_recursive(str, n, decimal_powers(decimal_levels(n)), out);
 }
 
 /**
- * @brief a helper function contains the logic for addition of two bigints
+ * @brief a helper function to convert decimal digits to limbs
  *
- * @param num1 a bigint that is always positive
- * @param num2 a bigint that is always positive
- * @return bigint the result of the addition
+ * The digits are read in chunks of up to 19, the largest power of 10 that fits in a limb,
+ * each converted by the kernels in bigint_digits.hpp and multiplied into the number with one
+ * pass over the limbs, so n digits cost O(n^2).
+ *
+ * @param str validated decimal digits, the most significant first
+ * @param n the number of digits
+ * @param out room for n / 19 + 1 limbs
+ * @return size_t the number of limbs written, without leading zeros
  */
-bigint bigint::add(const bigint &num1, const bigint &num2)
+size_t bigint::parse_chunks(const char *str, size_t n, bigint_limb *out)
 {
-    bigint result;
-    result.digits.clear(); // Remove leading zeros
-    int8_t carry = 0;      // when the sum of two digits is greater than 10, carry +1
-    int64_t i = 0;
-    const int8_t base = 10; // constant base for the digits is always 10
-
-    // perform the addition for each digits
-    while (i < (int64_t)num1.digits.size() || i < (int64_t)num2.digits.size())
+    constexpr std::array<bigint_limb, 20> powers = [] {
+        std::array<bigint_limb, 20> table{1};
+        for (size_t i = 1; i < table.size(); i++)
+        {
+            table[i] = table[i - 1] * 10;
+        }
+        return table;
+    }();
+    size_t chunk_size = n % decimal_chunk_digits;
+    if (chunk_size == 0)
     {
-        int8_t sum = carry;
-        if (i < (int64_t)num1.digits.size())
+        chunk_size = decimal_chunk_digits;
+    }
+    size_t length = 0;
+    for (size_t i = 0; i < n; i += chunk_size, chunk_size = decimal_chunk_digits)
+    {
+        bigint_limb carry = bigint_parse_digits(str + i, chunk_size);
+        for (size_t j = 0; j < length; j++)
         {
-            sum += num1.digits[(size_t)i];
+            bigint_double_limb t = bigint_double_limb(out[j]) * powers[chunk_size] + carry;
+            out[j] = bigint_limb(t);
+            carry = bigint_limb(t >> bigint_limb_bits);
         }
-        if (i < (int64_t)num2.digits.size())
+        if (carry != 0)
         {
-            sum += num2.digits[(size_t)i];
+            out[length++] = carry;
         }
-        result.digits.push_back(sum % base);
-        carry = sum / base;
-        i++;
-    }
-
-    // add remaining carry
-    if (carry > 0)
-    {
-        result.digits.push_back(carry);
     }
-
-    return result;
+    return length;
 }
 
 /**
- * @brief a helper function contains the logic for subtraction of two bigints
+ * @brief a helper function for the number of split points of divide-and-conquer conversion
  *
- * @param num1 a bigint that is larger than num2
- * @param num2 a bigint
- * @return bigint the result of the subtraction
+ * @param digits the number of decimal digits to be converted
+ * @return size_t the number of k with 19 * 2^k < digits
  */
-bigint bigint::subtract(const bigint &num1, const bigint &num2)
+size_t bigint::decimal_levels(size_t digits)
 {
-    bigint result;
-    result.digits.clear(); // Remove leading zeros
-    int8_t borrow = 0;     // when the difference of two digits is less than 0, borrow -1
-    int64_t i = 0;
-
-    bigint n1 = num1; // Create modifiable copies
-    bigint n2 = num2;
-
-    // If num2 is negative, convert to addition
-    if (n2.is_negative)
+    size_t levels = 0;
+    for (size_t chunk = decimal_chunk_digits; chunk < digits; chunk *= 2)
     {
-        n2 = negate(n2);
-        return add(n1, n2);
+        levels++;
     }
+    return levels;
+}
 
-    // perform the subtraction for each digits
-    while (i < (int64_t)n1.digits.size() || i < (int64_t)n2.digits.size())
+/**
+ * @brief a helper function for 10^(19 * 2^k), the split points of divide-and-conquer conversion
+ *
+ * The powers are kept per thread and only extended, so converting numbers of a size already
+ * seen squares nothing and allocates nothing.
+ *
+ * @param levels the number of powers needed
+ * @return const std::vector<bigint>& 10^(19 * 2^k) for k from 0 to at least levels - 1, each the square of the one before
+ */
+const std::vector<bigint> &bigint::decimal_powers(size_t levels)
+{
+    static thread_local std::vector<bigint> powers;
+    while (powers.size() < levels)
     {
-        int8_t diff = borrow; // Subtract the borrow
-        if (i < (int64_t)n1.digits.size())
-        {
-            diff += n1.digits[(size_t)i];
-        }
-        if (i < (int64_t)n2.digits.size())
-        {
-            diff -= n2.digits[(size_t)i];
-        }
-        if (diff < 0)
+        if (powers.empty())
         {
-            diff += 10;  // borrow from the next digit
-            borrow = -1; // reduce the next digit by 1
+            powers.emplace_back().limbs.push_back(10000000000000000000ULL); // 10^19
         }
         else
         {
-            borrow = 0;
+            powers.push_back(square(powers.back()));
         }
-
-        result.digits.push_back(diff);
-        i++;
-    }
-
-    // Remove leading zeros
-    while (result.digits.size() > 1 && result.digits.back() == 0)
-    {
-        result.digits.pop_back();
-    }
-
-    // Handle zero result
-    if (result.digits.size() == 1 && result.digits[0] == 0)
-    {
-        result.is_negative = false;
     }
-
-    return result;
+    return powers;
 }
 
 /**
- * @brief a helper function to compare two bigints and determine if num1 is smaller than num2
+ * @brief a helper function to parse decimal digits by divide and conquer
  *
- * @param num1 a bigint
- * @param num2 a bigint
- * @return true if num1 is smaller than num2
- * @return false if num1 is larger than num2
+ * The digits are split so that the low part has 19 * 2^k digits, the most below n, and the
+ * value is high * 10^(19 * 2^k) + low. Both halves recurse into the scratch arena, so with
+ * Karatsuba multiplication the whole conversion costs a few multiplications of the result's
+ * size and allocates nothing.
+ *
+ * @param str validated decimal digits, the most significant first
+ * @param n the number of digits
+ * @param powers decimal_powers(decimal_levels(m)) for some m >= n
+ * @param out room for n / 19 + 1 limbs
+ * @return size_t the number of limbs written, without leading zeros
  */
-bool bigint::is_smaller(const bigint &num1, const bigint &num2) const
+size_t bigint::parse_recursive(const char *str, size_t n, const std::vector<bigint> &powers, bigint_limb *out)
 {
-    if (num1.is_negative && num2.is_negative)
-    { // Both negative, compare absolute values in reverse
-        bigint n1 = negate(num1);
-        bigint n2 = negate(num2);
-        return is_smaller(n2, n1);
-    }
-
-    if (num1.is_negative && !num2.is_negative)
-    {
-        return true; // negative is always smaller than positive
-    }
-
-    if (!num1.is_negative && num2.is_negative)
+    if (n < bigint_threshold(&bigint_thresholds::recursive_conversion) * decimal_chunk_digits || n <= decimal_chunk_digits)
     {
-        return false; // positive is always larger than negative
+        return parse_chunks(str, n, out);
     }
-
-    if (num1.digits.size() < num2.digits.size())
+    size_t k = 0;
+    while (decimal_chunk_digits << (k + 1) < n)
     {
-        return true; // fewer digits means smaller
+        k++;
     }
-
-    if (num1.digits.size() > num2.digits.size())
+    size_t low = decimal_chunk_digits << k;
+
+    bigint_scratch_frame frame;
+    bigint_limb *high = frame.take((n - low) / decimal_chunk_digits + 1);
+    bigint_limb *rest = frame.take(low / decimal_chunk_digits + 1);
+    size_t hn = parse_recursive(str, n - low, powers, high);
+    size_t ln = parse_recursive(str + n - low, low, powers, rest);
+    if (hn == 0)
     {
-        return false; // more digits means larger
+        std::copy(rest, rest + ln, out);
+        return ln;
     }
 
-    // if the number of digits are the same, compare each digit from the most significant digit
-    for (int64_t i = (int64_t)num1.digits.size() - 1; i >= 0; i--)
+    // 10^low < 2^(64 * low / 19), so the product fits in the n / 19 + 1 limbs of out
+    const limb_vector &power = powers[k].limbs;
+    size_t length = hn + power.size();
+    mul_limbs(out, high, hn, power.data(), power.size());
+    bigint_mpn_add(out, out, length, rest, ln);
+    while (length > 0 && out[length - 1] == 0)
     {
-        // Compare each digit from the most significant digit
-        if (num1.digits[(size_t)i] < num2.digits[(size_t)i])
-        {
-            return true;
-        }
-        if (num1.digits[(size_t)i] > num2.digits[(size_t)i])
-        {
-            return false;
-        }
+        length--;
     }
-    return false; // Numbers are equal
+    return length;
 }
 
-// operator logic
 /**
- * @brief Overload the + operator to perform addition of two bigints using helper functions
+ * @brief Construct a new bigint object from a view, copying the viewed limbs
  *
- * @param other a bigint to be added
- * @return bigint the result of the addition
+ * @param view a bigint_view to be copied
  */
-bigint bigint::operator+(const bigint &other)
+bigint::bigint(bigint_view view)
 {
-    bigint result;
+    BIGINT_COUNT_OP(bigint_op::construct);
+    view = view.trimmed();
+    is_negative = view.negative() && !view.is_zero();
+    limbs.assign(view.limbs().begin(), view.limbs().end());
+}
 
-    // Case 1: Same sign -> Perform addition
-    if (is_negative == other.is_negative)
-    {
-        result = add(*this, other);       // add takes two positive numbers and returns a positive number
-        result.is_negative = is_negative; // assign the sign of the result based on the sign of either number
-    }
-    // Case 2: Different signs -> Perform subtraction
-    else
-    {
-        // num1 < num2, calculate num2 - (+num)
-        if (is_smaller(*this, other))
-        {
-            bigint n1 = negate(*this);
-            bigint n2 = other;
-            result = n2 - n1; // pass to operator- to perform subtraction and handle the sign
-        }
-        // num1 > num2, calculate num1 - (+num2)
-        else
-        {
-            bigint n2 = negate(other);
-            result = *this - n2; // pass to operator- to perform subtraction and handle the sign
-        }
-    }
+/**
+ * @brief Construct a new bigint_view object that views zero
+ *
+ */
+bigint_view::bigint_view() : span(), is_negative(false) {}
 
-    return result;
-}
+/**
+ * @brief Construct a new bigint_view object over limbs stored elsewhere
+ *
+ * @param limbs little endian base 2^64 limbs
+ * @param negative true if the viewed number is negative
+ */
+bigint_view::bigint_view(std::span<const bigint_limb> limbs, bool negative) : span(limbs), is_negative(negative) {}
 
 /**
- * @brief Overload the += operator to perform addition of two bigints use operator+()
+ * @brief Construct a new bigint_view object over a whole bigint
  *
- * @param other a bigint to be added
- * @return bigint the result of the addition
+ * @param num a bigint to be viewed, it must outlive the view
  */
-bigint bigint::operator+=(const bigint &other)
+bigint_view::bigint_view(const bigint &num) : span(num.limbs), is_negative(num.is_negative) {}
+
+/**
+ * @brief the viewed limbs
+ *
+ * @return std::span<const bigint_limb> the limbs in little endian order
+ */
+std::span<const bigint_limb> bigint_view::limbs() const
 {
-    *this = *this + other;
-    return *this;
+    return span;
 }
 
 /**
- * @brief Overload the - operator to perform subtraction of two bigints using helper functions
+ * @brief the sign of the view
  *
- * @param other a bigint to be subtracted
- * @return bigint the result of the subtraction
+ * @return true if the view is negative
+ * @return false if the view is positive
  */
-bigint bigint::operator-(const bigint &other)
+bool bigint_view::negative() const
 {
-    bigint result;
-
-    // second number is negative, convert to addition
-    if (other.is_negative)
-    {
-        bigint n2 = negate(other);
-        result = *this + n2; // pass to operator+ to perform addition and handle the sign
-    }
-    else
-    {
-        // equivalent to addition
-        if (is_negative)
-        {
-            // −num1−(-num2)=−(num1+num2)
-            bigint n1 = negate(*this);
-            result = add(n1, other);
-            result.is_negative = true; // num1 < num2, result is negative
-        }
-        // when both numbers have same sign
-        else
-        {
-            // num1 < num2, calculate num2 - num1
-            if (is_smaller(*this, other))
-            {
-                result = subtract(other, *this);
-                result.is_negative = true; // num1 < num2, result is negative
-            }
-            // num1 > num2, calculate num1 - num2
-            else
-            {
-                result = subtract(*this, other);
-            }
-        }
-    }
-    return result;
+    return is_negative;
 }
 
 /**
- * @brief Overload the -= operator to perform subtraction of two bigints use  operator-()
- * @param other a bigint to be subtracted
- * @return bigint the result of the subtraction
+ * @brief the number of viewed limbs
+ *
+ * @return size_t the number of limbs, including leading zeros
  */
-bigint bigint::operator-=(const bigint &other)
+size_t bigint_view::size() const
 {
-    *this = *this - other;
-    return *this;
+    return span.size();
 }
 
 /**
- * @brief Overload the * operator to perform multiplication of two bigints using long multiplication method
+ * @brief Overload the [] operator to read a limb
  *
- * @param other
- * @return bigint the result of the multiplication
+ * @param i the position of the limb, 0 is the least significant limb
+ * @return bigint_limb the limb, or 0 if i is past the most significant limb
  */
-bigint bigint::operator*(const bigint &other)
+bigint_limb bigint_view::operator[](size_t i) const
 {
-    bigint result;
-
-    if ((digits.size() == 1 && digits[0] == 0) || (other.digits.size() == 1 && other.digits[0] == 0))
-    {
-        result.is_negative = false;
-        return result;
-    }
+    return i < span.size() ? span[i] : 0;
+}
 
-    for (int64_t i = 0; i < (int64_t)digits.size(); i++)
+/**
+ * @brief check if the view is zero
+ *
+ * @return true if every limb is zero
+ * @return false otherwise
+ */
+bool bigint_view::is_zero() const
+{
+    for (bigint_limb limb : span)
     {
-        bigint temp;                // temporary bigint to store the result of each digit multiplication
-        int8_t carry = 0;           // carry from the previous digit multiplication
-        temp.digits.clear();        // remove leading zeros
-        constexpr int8_t base = 10; // constant base for the digits is always 10
-
-        // perform the multiplication for each digit
-        for (int64_t j = 0; j < (int64_t)other.digits.size(); j++)
+        if (limb != 0)
         {
-            int8_t product = int8_t(digits[(size_t)i] * other.digits[(size_t)j] + carry);
-            temp.digits.push_back(product % base);
-            carry = (product / base);
-        }
-
-        // add remaining carry
-        if (carry > 0)
-        {
-            temp.digits.push_back(carry);
-        }
-
-        // shift the digits in temp based on the current position in the first number
-        for (int64_t j = 0; j < i; j++)
-        {
-            temp.digits.insert(temp.digits.begin(), 0); // Insert zeros at the beginning
+            return false;
         }
-
-        result += temp;
     }
-
-    result.is_negative = is_negative ^ other.is_negative;
-    return result;
+    return true;
 }
 
 /**
- * @brief Overload the *= operator to perform multiplication of two bigints use operator*()
+ * @brief the number of bits needed for the absolute value
  *
- * @param other a bigint to be multiplied
- * @return bigint the result of the multiplication
+ * @return size_t the position of the highest set bit plus one, 0 for zero
  */
-bigint bigint::operator*=(const bigint &other)
+size_t bigint_view::bit_length() const
 {
-    *this = *this * other;
-    return *this;
+    bigint_view num = trimmed();
+    if (num.size() == 0)
+    {
+        return 0;
+    }
+    return (num.size() - 1) * bigint_limb_bits + size_t(std::bit_width(num.span.back()));
 }
 
 /**
- * @brief Overload the - operator to negate a bigint
+ * @brief the number of set bits in the absolute value
  *
- * @return bigint the negated bigint
+ * @return size_t the number of ones
  */
-bigint bigint::operator-()
+size_t bigint_view::popcount() const
 {
-    bigint result = *this;
-    result.is_negative = !is_negative;
-    return result;
+    size_t count = 0;
+    for (bigint_limb limb : span)
+    {
+        count += size_t(std::popcount(limb));
+    }
+    return count;
 }
 
 /**
- * @brief Overload the == operator to compare two bigints
+ * @brief the number of trailing zero bits, the same for a number and its negation
  *
- * @param other a bigint to be compared
- * @return true if the two bigints are equal
- * @return false if the two bigints are not equal
+ * @return size_t the position of the lowest set bit, 0 for zero
  */
-bool bigint::operator==(const bigint &other) const
+size_t bigint_view::countr_zero() const
 {
-
-    if (is_negative != other.is_negative || digits.size() != other.digits.size())
+    for (size_t i = 0; i < span.size(); i++)
     {
-        return false;
-    }
-
-    // compare each digit
-    for (size_t i = 0; i < digits.size(); i++)
-    {
-        int8_t digit1 = digits[i];
-        int8_t digit2 = other.digits[i];
-
-        if (digit1 != digit2)
+        if (span[i] != 0)
         {
-            return false;
+            return i * bigint_limb_bits + size_t(std::countr_zero(span[i]));
         }
     }
-    return true;
+    return 0;
 }
 
 /**
- * @brief Overload the != operator to compare two bigints
+ * @brief a view of a range of limbs, the result is never negative
  *
- * @param other a bigint to be compared
- * @return true if the two bigints are not equal
- * @return false if the two bigints are equal
+ * @param offset the position of the first limb in the range
+ * @param count the number of limbs in the range, clamped to the end of the view
+ * @return bigint_view the value of limbs [offset, offset + count)
  */
-bool bigint::operator!=(const bigint &other) const
+bigint_view bigint_view::subview(size_t offset, size_t count) const
 {
-    return !(*this == other);
+    if (offset >= span.size())
+    {
+        return bigint_view();
+    }
+    return bigint_view(span.subspan(offset, std::min(count, span.size() - offset)));
 }
 
 /**
- * @brief Overload the < operator to compare two bigints
+ * @brief a view of the absolute value
  *
- * @param other a bigint to be compared
- * @return true if the first bigint is smaller than the second bigint
- * @return false if the first bigint is larger than the second bigint
+ * @return bigint_view the view with the sign dropped
  */
-bool bigint::operator<(const bigint &other) const
+bigint_view bigint_view::abs() const
 {
-    return is_smaller(*this, other);
+    return bigint_view(span);
 }
 
 /**
- * @brief Overload the <= operator to compare two bigints
+ * @brief Overload the - operator to negate a view without copying
  *
- * @param other a bigint to be compared
- * @return true if the first bigint is smaller than or equal to the second bigint
- * @return false if the first bigint is larger than the second bigint
+ * @return bigint_view the view with the sign flipped
  */
-bool bigint::operator<=(const bigint &other) const
+bigint_view bigint_view::operator-() const
 {
-    if (*this == other)
-    {
-        return true;
-    }
-    return is_smaller(*this, other);
+    return bigint_view(span, !is_negative);
 }
 
 /**
- * @brief Overload the > operator to compare two bigints
+ * @brief a view without leading zeros, zero is viewed as an empty span
  *
- * @param other a bigint to be compared
- * @return true if the first bigint is larger than the second bigint
- * @return false if the first bigint is smaller than the second bigint
+ * @return bigint_view the trimmed view
  */
-bool bigint::operator>(const bigint &other) const
+bigint_view bigint_view::trimmed() const
 {
-    return is_smaller(other, *this);
+    size_t size = span.size();
+    while (size > 0 && span[size - 1] == 0)
+    {
+        size--;
+    }
+    return bigint_view(span.first(size), is_negative);
 }
 
 /**
- * @brief Overload the >= operator to compare two bigints
+ * @brief a helper function to remove leading zero limbs and the sign of zero
  *
- * @param other a bigint to be compared
- * @return true if the first bigint is larger than or equal to the second bigint
- * @return false if the first bigint is smaller than the second bigint
  */
-bool bigint::operator>=(const bigint &other) const
+void bigint::trim()
 {
-    if (*this == other)
+    while (!limbs.empty() && limbs.back() == 0)
     {
-        return true;
+        limbs.pop_back();
+    }
+    if (limbs.empty())
+    {
+        is_negative = false;
     }
-    return is_smaller(other, *this);
 }
 
 /**
- * @brief Overload the << operator to print a bigint to an output stream
+ * @brief a helper function to multiply the absolute value by a limb and add a limb, in place
+ *
+ * @param m a limb multiplier
+ * @param a a limb addend
+ * @return bigint_limb the carry that was appended as a new limb, 0 if none
+ */
+bigint_limb bigint::multiply_add_small(bigint_limb m, bigint_limb a)
+{
+    bigint_limb carry = a;
+    for (bigint_limb &limb : limbs)
+    {
+        bigint_double_limb t = bigint_double_limb(limb) * m + carry;
+        limb = bigint_limb(t);
+        carry = bigint_limb(t >> bigint_limb_bits);
+    }
+    if (carry > 0)
+    {
+        limbs.push_back(carry);
+    }
+    return carry;
+}
+
+/**
+ * @brief a helper function to divide the absolute value by a limb, in place
+ *
+ * @param d a non-zero limb divisor
+ * @return bigint_limb the remainder
+ */
+bigint_limb bigint::divide_small(bigint_limb d)
+{
+    bigint_double_limb remainder = 0;
+    for (size_t i = limbs.size(); i > 0; i--)
+    {
+        remainder = (remainder << bigint_limb_bits) | limbs[i - 1];
+        limbs[i - 1] = bigint_limb(remainder / d);
+        remainder %= d;
+    }
+    trim();
+    return bigint_limb(remainder);
+}
+
+/**
+ * @brief a helper function to find the remainder of the absolute value divided by a limb
+ *
+ * @param d a non-zero limb divisor
+ * @return bigint_limb the remainder
+ */
+bigint_limb bigint::remainder_small(bigint_limb d) const
+{
+    bigint_double_limb remainder = 0;
+    for (size_t i = limbs.size(); i > 0; i--)
+    {
+        remainder = ((remainder << bigint_limb_bits) | limbs[i - 1]) % d;
+    }
+    return bigint_limb(remainder);
+}
+
+/**
+ * @brief a helper function to add a signed limb in place
+ *
+ * When the signs agree the carry is propagated only until it dies out, and when they differ
+ * the borrow is, so adding 1 to a number touches a single limb except on a run of all-ones limbs.
+ *
+ * @param m the absolute value of the addend
+ * @param negative true if the addend is negative
+ */
+void bigint::add_small(bigint_limb m, bool negative)
+{
+    if (m == 0)
+    {
+        return;
+    }
+    if (limbs.empty())
+    {
+        limbs.push_back(m);
+        is_negative = negative;
+    }
+    else if (negative == is_negative)
+    {
+        for (size_t i = 0; m != 0; i++)
+        {
+            if (i == limbs.size())
+            {
+                limbs.push_back(m);
+                break;
+            }
+            limbs[i] += m;
+            m = limbs[i] < m ? 1 : 0;
+        }
+    }
+    else if (limbs.size() > 1 || limbs[0] >= m)
+    {
+        for (size_t i = 0; m != 0; i++)
+        {
+            bigint_limb borrow = limbs[i] < m ? 1 : 0;
+            limbs[i] -= m;
+            m = borrow;
+        }
+        trim();
+    }
+    else
+    {
+        // |m| exceeds the single limb, so the sign flips
+        limbs[0] = m - limbs[0];
+        is_negative = negative;
+    }
+}
+
+/**
+ * @brief a helper function to multiply by a signed limb in place
+ *
+ * @param m the absolute value of the multiplier
+ * @param negative true if the multiplier is negative
+ */
+void bigint::multiply_small(bigint_limb m, bool negative)
+{
+    if (m == 0)
+    {
+        limbs.clear();
+        is_negative = false;
+        return;
+    }
+    multiply_add_small(m, 0);
+    is_negative = is_negative != negative;
+}
+
+/**
+ * @brief a helper function to divide by a signed limb in place, truncating towards zero
+ *
+ * @param m the absolute value of the divisor
+ * @param negative true if the divisor is negative
+ * @return bigint_limb the absolute value of the remainder
+ */
+bigint_limb bigint::divmod_small(bigint_limb m, bool negative)
+{
+    if (m == 0)
+    {
+        throw std::domain_error("Division by zero");
+    }
+    bool quotient_negative = is_negative != negative;
+    bigint_limb remainder = divide_small(m);
+    is_negative = quotient_negative && !limbs.empty();
+    return remainder;
+}
+
+/**
+ * @brief a helper function to find the absolute value of a native integer
+ *
+ * @tparam T a native integer type
+ * @param num a native integer
+ * @return bigint_limb its absolute value, negated in unsigned arithmetic so that the minimum does not overflow
+ */
+template <bigint_native_integer T>
+bigint_limb bigint::native_magnitude(T num)
+{
+    if constexpr (std::is_signed_v<T>)
+    {
+        return num < 0 ? 0 - bigint_limb(num) : bigint_limb(num);
+    }
+    else
+    {
+        return bigint_limb(num);
+    }
+}
+
+/**
+ * @brief a helper function to find the sign of a native integer
+ *
+ * @tparam T a native integer type
+ * @param num a native integer
+ * @return true if num is negative
+ */
+template <bigint_native_integer T>
+bool bigint::native_negative(T num)
+{
+    if constexpr (std::is_signed_v<T>)
+    {
+        return num < 0;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+/**
+ * @brief a helper function contains the logic for addition of two bigints
+ *
+ * @param num1 a view whose sign is ignored
+ * @param num2 a view whose sign is ignored
+ * @return bigint the result of the addition
+ */
+bigint bigint::add(bigint_view num1, bigint_view num2)
+{
+    if (num1.size() < num2.size())
+    {
+        std::swap(num1, num2);
+    }
+    const bigint_limb *a = num1.limbs().data();
+    size_t size = num1.size();
+    size_t common = num2.size();
+
+    bigint result;
+    result.limbs.resize(size + 1);
+    result.limbs[size] = bigint_mpn_add(result.limbs.data(), a, size, num2.limbs().data(), common);
+    result.trim();
+    return result;
+}
+
+/**
+ * @brief a helper function contains the logic for subtraction of two bigints
+ *
+ * The operands are read in place, no copies are made.
+ *
+ * @param num1 a view whose absolute value is larger than num2, its sign is ignored
+ * @param num2 a view whose sign is ignored
+ * @return bigint the result of the subtraction
+ */
+bigint bigint::subtract(bigint_view num1, bigint_view num2)
+{
+    num2 = num2.trimmed(); // |num1| > |num2|, so num2 has no more significant limbs than num1
+    const bigint_limb *a = num1.limbs().data();
+    size_t size = num1.size();
+    size_t common = num2.size();
+
+    bigint result;
+    result.limbs.resize(size);
+    bigint_mpn_sub(result.limbs.data(), a, size, num2.limbs().data(), common);
+
+    // Remove leading zeros
+    result.trim();
+    return result;
+}
+
+/**
+ * @brief a helper function to compare the absolute values of two numbers
+ *
+ * @param num1 a view whose sign is ignored
+ * @param num2 a view whose sign is ignored
+ * @return int -1 if |num1| < |num2|, 0 if they are equal, 1 if |num1| > |num2|
+ */
+int bigint::compare_magnitude(bigint_view num1, bigint_view num2)
+{
+    num1 = num1.trimmed();
+    num2 = num2.trimmed();
+
+    if (num1.size() != num2.size())
+    {
+        return num1.size() < num2.size() ? -1 : 1; // fewer limbs means smaller
+    }
+
+    // if the number of limbs are the same, compare each limb from the most significant limb
+    return bigint_mpn_cmp(num1.limbs().data(), num2.limbs().data(), num1.size());
+}
+
+/**
+ * @brief a helper function to compare two numbers and determine if num1 is smaller than num2
+ *
+ * @param num1 a view
+ * @param num2 a view
+ * @return true if num1 is smaller than num2
+ * @return false if num1 is larger than or equal to num2
+ */
+bool bigint::is_smaller(bigint_view num1, bigint_view num2)
+{
+    BIGINT_COUNT_OP(bigint_op::compare);
+    // zero has no sign
+    bool negative1 = num1.negative() && !num1.is_zero();
+    bool negative2 = num2.negative() && !num2.is_zero();
+
+    if (negative1 != negative2)
+    {
+        return negative1; // negative is always smaller than positive
+    }
+
+    // Both negative, compare absolute values in reverse
+    int order = compare_magnitude(num1, num2);
+    return negative1 ? order > 0 : order < 0;
+}
+
+/**
+ * @brief a helper function to write a number as sign extended two's complement limbs
+ *
+ * @param num a view
+ * @param size the number of limbs to write, larger than the number of limbs of num
+ * @return limb_vector the two's complement limbs, the top limb holds only sign bits
+ */
+bigint::limb_vector bigint::to_twos_complement(bigint_view num, size_t size)
+{
+    limb_vector result(size, 0);
+    std::copy(num.limbs().begin(), num.limbs().end(), result.begin());
+
+    if (num.negative())
+    {
+        // -x = ~x + 1
+        bigint_limb carry = 1;
+        for (bigint_limb &limb : result)
+        {
+            limb = ~limb + carry;
+            carry = carry && limb == 0;
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief a helper function to read sign extended two's complement limbs
+ *
+ * @param twos the two's complement limbs, the top limb holds only sign bits
+ * @return bigint the value of the limbs
+ */
+bigint bigint::from_twos_complement(limb_vector twos)
+{
+    bigint result;
+    result.is_negative = !twos.empty() && (twos.back() >> (bigint_limb_bits - 1)) != 0;
+    if (result.is_negative)
+    {
+        // |x| = ~x + 1
+        bigint_limb carry = 1;
+        for (bigint_limb &limb : twos)
+        {
+            limb = ~limb + carry;
+            carry = carry && limb == 0;
+        }
+    }
+    result.limbs = std::move(twos);
+    result.trim();
+    return result;
+}
+
+/**
+ * @brief a helper function to apply a bitwise operation to two numbers in two's complement
+ *
+ * @param num1 a view
+ * @param num2 a view
+ * @param op the operation applied to each pair of limbs
+ * @return bigint the result of the operation
+ */
+template <typename Op>
+bigint bigint::bitwise(bigint_view num1, bigint_view num2, Op op)
+{
+    num1 = num1.trimmed();
+    num2 = num2.trimmed();
+    size_t size = std::max(num1.size(), num2.size()) + 1; // one more limb for the sign bits
+    limb_vector twos1 = to_twos_complement(num1, size);
+    limb_vector twos2 = to_twos_complement(num2, size);
+    for (size_t i = 0; i < size; i++)
+    {
+        twos1[i] = op(twos1[i], twos2[i]);
+    }
+    return from_twos_complement(std::move(twos1));
+}
+
+/**
+ * @brief a helper function contains the sign handling of addition, shared by operator+ and operator-
+ *
+ * @param num1 a view to be added
+ * @param num2 a view to be added
+ * @return bigint the result of the addition
+ */
+bigint bigint::signed_add(bigint_view num1, bigint_view num2)
+{
+    bigint result;
+
+    // Case 1: Same sign -> Perform addition
+    if (num1.negative() == num2.negative())
+    {
+        result = add(num1, num2);             // add takes two positive numbers and returns a positive number
+        result.is_negative = num1.negative(); // assign the sign of the result based on the sign of either number
+    }
+    // Case 2: Different signs -> Perform subtraction of the smaller magnitude from the larger one
+    // num1+(−num2)=num1−num2, (−num1)+num2=num2−num1
+    else if (compare_magnitude(num1, num2) < 0)
+    {
+        result = subtract(num2, num1);
+        result.is_negative = num2.negative();
+    }
+    else
+    {
+        result = subtract(num1, num2);
+        result.is_negative = num1.negative();
+    }
+
+    // Handle zero result
+    result.trim();
+    return result;
+}
+
+// operator logic
+/**
+ * @brief Overload the + operator to perform addition of two views using helper functions
+ *
+ * @param num1 a view to be added
+ * @param num2 a view to be added
+ * @return bigint the result of the addition
+ */
+bigint operator+(bigint_view num1, bigint_view num2)
+{
+    BIGINT_COUNT_OP(bigint_op::add);
+    return bigint::signed_add(num1, num2);
+}
+
+/**
+ * @brief Overload the - operator to perform subtraction of two views, num1 - num2 = num1 + (-num2)
+ *
+ * @param num1 a view to be subtracted from
+ * @param num2 a view to be subtracted
+ * @return bigint the result of the subtraction
+ */
+bigint operator-(bigint_view num1, bigint_view num2)
+{
+    BIGINT_COUNT_OP(bigint_op::subtract);
+    return bigint::signed_add(num1, -num2); // flipping the sign of a view does not copy its limbs
+}
+
+/**
+ * @brief Overload the + operator to perform addition of two bigints using helper functions
+ *
+ * @param other a bigint to be added
+ * @return bigint the result of the addition
+ */
+bigint bigint::operator+(const bigint &other) const
+{
+    return bigint_view(*this) + bigint_view(other);
+}
+
+/**
+ * @brief Overload the += operator to perform addition of two bigints use operator+()
+ *
+ * @param other a bigint to be added
+ * @return bigint the result of the addition
+ */
+bigint bigint::operator+=(const bigint &other)
+{
+    *this = *this + other;
+    return *this;
+}
+
+/**
+ * @brief Overload the += operator to add a view, the view may refer to this bigint
+ *
+ * @param other a view to be added
+ * @return bigint the result of the addition
+ */
+bigint bigint::operator+=(bigint_view other)
+{
+    *this = bigint_view(*this) + other;
+    return *this;
+}
+
+/**
+ * @brief Overload the - operator to perform subtraction of two bigints using helper functions
+ *
+ * @param other a bigint to be subtracted
+ * @return bigint the result of the subtraction
+ */
+bigint bigint::operator-(const bigint &other) const
+{
+    return bigint_view(*this) - bigint_view(other);
+}
+
+/**
+ * @brief Overload the -= operator to perform subtraction of two bigints use  operator-()
+ * @param other a bigint to be subtracted
+ * @return bigint the result of the subtraction
+ */
+bigint bigint::operator-=(const bigint &other)
+{
+    *this = *this - other;
+    return *this;
+}
+
+/**
+ * @brief Overload the -= operator to subtract a view, the view may refer to this bigint
+ *
+ * @param other a view to be subtracted
+ * @return bigint the result of the subtraction
+ */
+bigint bigint::operator-=(bigint_view other)
+{
+    *this = bigint_view(*this) - other;
+    return *this;
+}
+
+/**
+ * @brief Overload the * operator to perform multiplication of two views
+ *
+ * Long multiplication is used while the shorter operand has fewer than
+ * bigint_active_thresholds.karatsuba limbs, and Karatsuba's method above that.
+ *
+ * @param num1 a view to be multiplied
+ * @param num2 a view to be multiplied
+ * @return bigint the result of the multiplication
+ */
+bigint operator*(bigint_view num1, bigint_view num2)
+{
+    BIGINT_COUNT_OP(bigint_op::multiply);
+    bigint result;
+    num1 = num1.trimmed();
+    num2 = num2.trimmed();
+
+    if (num1.size() == 0 || num2.size() == 0)
+    {
+        return result;
+    }
+    if (num1.limbs().data() == num2.limbs().data() && num1.size() == num2.size())
+    {
+        // two views of the same limbs may still differ in sign, as in v * -v
+        result = bigint::square(num1);
+        result.is_negative = num1.negative() != num2.negative();
+        return result;
+    }
+
+    BIGINT_COUNT_ALGORITHM(std::min(num1.size(), num2.size()) < bigint_threshold(&bigint_thresholds::karatsuba) ? bigint_algorithm::mul_schoolbook
+                                                                                                                : bigint_algorithm::mul_karatsuba,
+                           std::max(num1.size(), num2.size()));
+    result.limbs.resize(num1.size() + num2.size());
+    if (num1.size() <= bigint_small_limbs && num2.size() <= bigint_small_limbs)
+    {
+        bigint_mpn_mul_basecase(result.limbs.data(), num1.limbs().data(), num1.size(), num2.limbs().data(), num2.size());
+    }
+    else
+    {
+        bigint::mul_limbs(result.limbs.data(), num1.limbs().data(), num1.size(), num2.limbs().data(), num2.size());
+    }
+
+    result.is_negative = num1.negative() ^ num2.negative();
+    result.trim();
+    return result;
+}
+
+/**
+ * @brief a helper function to multiply two limb arrays, with Karatsuba's method for large operands
+ *
+ * With a = a1 * B^h + a0 and b = b1 * B^h + b0, where B = 2^64 and h is half the longer length,
+ * a * b = z2 * B^2h + (z1 - z2 - z0) * B^h + z0 with z0 = a0 * b0, z2 = a1 * b1 and
+ * z1 = (a0 + a1)(b0 + b1): three half-size products instead of four, O(n^1.585) in total.
+ * An operand shorter than h is cut into pieces of its partner's length instead.
+ *
+ * @param out n + m limbs, overwritten with the product, not overlapping a or b
+ * @param a n limbs
+ * @param n the number of limbs of a, n > 0
+ * @param b m limbs
+ * @param m the number of limbs of b, m > 0
+ */
+void bigint::mul_limbs(bigint_limb *out, const bigint_limb *a, size_t n, const bigint_limb *b, size_t m)
+{
+    if (n < m)
+    {
+        std::swap(a, b);
+        std::swap(n, m);
+    }
+    if (m < bigint_threshold(&bigint_thresholds::karatsuba))
+    {
+        bigint_mpn_mul_basecase(out, a, n, b, m);
+        return;
+    }
+
+    size_t h = (n + 1) / 2;
+    if (m <= h)
+    {
+        // unbalanced: multiply b by pieces of a of its own length and add them up
+        std::fill(out, out + n + m, bigint_limb(0));
+        bigint_scratch_frame frame;
+        bigint_limb *piece = frame.take(2 * m);
+        for (size_t i = 0; i < n; i += m)
+        {
+            size_t length = std::min(m, n - i);
+            mul_limbs(piece, a + i, length, b, m);
+            bigint_mpn_add(out + i, out + i, n + m - i, piece, length + m);
+        }
+        return;
+    }
+
+    // z0 and z2 go straight into the low and high halves of the output
+    size_t n1 = n - h;
+    size_t m1 = m - h;
+    mul_limbs(out, a, h, b, h);
+    mul_limbs(out + 2 * h, a + h, n1, b + h, m1);
+
+    // z1 = (a0 + a1)(b0 + b1) - z0 - z2
+    bigint_scratch_frame frame;
+    bigint_limb *sum_a = frame.take(h + 1);
+    bigint_limb *sum_b = frame.take(h + 1);
+    std::copy(a, a + h, sum_a);
+    std::copy(b, b + h, sum_b);
+    sum_a[h] = bigint_mpn_add(sum_a, sum_a, h, a + h, n1);
+    sum_b[h] = bigint_mpn_add(sum_b, sum_b, h, b + h, m1);
+    size_t sa = sum_a[h] != 0 ? h + 1 : h;
+    size_t sb = sum_b[h] != 0 ? h + 1 : h;
+    size_t middle_size = sa + sb;
+    bigint_limb *middle = frame.take(middle_size);
+    mul_limbs(middle, sum_a, sa, sum_b, sb);
+    bigint_mpn_sub(middle, middle, middle_size, out, 2 * h);
+    bigint_mpn_sub(middle, middle, middle_size, out + 2 * h, n1 + m1);
+
+    // a0 * b1 + a1 * b0 fits in the limbs above h, so its top limbs are zero where the output ends
+    size_t length = std::min(middle_size, n + m - h);
+    bigint_mpn_add(out + h, out + h, n + m - h, middle, length);
+}
+
+/**
+ * @brief a helper function to add or subtract a product in place, row by row
+ *
+ * The accumulator is widened to hold the result and each limb of the shorter operand adds
+ * (addmul_1) or subtracts (submul_1) one row of the product directly into its limbs. When the
+ * subtraction crosses zero the limbs hold the result in two's complement, and one negation
+ * at the end turns it back into sign and magnitude.
+ *
+ * @param acc the accumulator
+ * @param num1 a view, which may refer to acc
+ * @param num2 a view, which may refer to acc
+ * @param subtract true for acc -= num1 * num2, false for acc += num1 * num2
+ */
+void bigint::multiply_accumulate(bigint &acc, bigint_view num1, bigint_view num2, bool subtract)
+{
+    num1 = num1.trimmed();
+    num2 = num2.trimmed();
+    if (num1.size() == 0 || num2.size() == 0)
+    {
+        return;
+    }
+
+    // widening acc would invalidate views of it, so an operand that refers to acc is copied first
+    const bigint_limb *begin = acc.limbs.data();
+    const bigint_limb *end = begin + acc.limbs.size();
+    auto refers_to_acc = [&](bigint_view num)
+    { return num.limbs().data() < end && num.limbs().data() + num.size() > begin; };
+    if (refers_to_acc(num1) || refers_to_acc(num2))
+    {
+        bigint copy1(num1);
+        bigint copy2(num2);
+        multiply_accumulate(acc, copy1, copy2, subtract);
+        return;
+    }
+
+    if (num1.size() < num2.size())
+    {
+        std::swap(num1, num2); // one row per limb of the shorter operand
+    }
+    bool product_negative = (num1.negative() != num2.negative()) != subtract;
+    if (acc.limbs.empty())
+    {
+        acc.is_negative = product_negative;
+    }
+    size_t n = num1.size();
+    size_t size = std::max(acc.limbs.size(), n + num2.size()) + 1;
+    acc.limbs.resize(size, 0);
+    bigint_limb *out = acc.limbs.data();
+
+    if (product_negative == acc.is_negative)
+    {
+        for (size_t j = 0; j < num2.size(); j++)
+        {
+            bigint_limb carry = bigint_mpn_addmul_1(out + j, num1.limbs().data(), n, num2[j]);
+            for (size_t i = j + n; carry != 0; i++)
+            {
+                out[i] += carry;
+                carry = out[i] < carry ? 1 : 0;
+            }
+        }
+    }
+    else
+    {
+        for (size_t j = 0; j < num2.size(); j++)
+        {
+            bigint_limb borrow = bigint_mpn_submul_1(out + j, num1.limbs().data(), n, num2[j]);
+            for (size_t i = j + n; borrow != 0 && i < size; i++)
+            {
+                bigint_limb before = out[i];
+                out[i] -= borrow;
+                borrow = before < borrow ? 1 : 0;
+            }
+        }
+
+        // |acc - product| fits below the top limb, so a non-zero top limb means the result is negative
+        if (out[size - 1] != 0)
+        {
+            bigint_limb carry = 1;
+            for (size_t i = 0; i < size; i++)
+            {
+                out[i] = ~out[i] + carry;
+                carry = (carry != 0 && out[i] == 0) ? 1 : 0;
+            }
+            acc.is_negative = !acc.is_negative;
+        }
+    }
+    acc.trim();
+}
+
+/**
+ * @brief fused multiply-add, acc += num1 * num2 without materialising the product
+ *
+ * @param acc the accumulator
+ * @param num1 a view, which may refer to acc
+ * @param num2 a view, which may refer to acc
+ */
+void fma(bigint &acc, bigint_view num1, bigint_view num2)
+{
+    BIGINT_COUNT_OP(bigint_op::multiply);
+    BIGINT_COUNT_ALGORITHM(bigint_algorithm::addmul, std::max(num1.size(), num2.size()));
+    bigint::multiply_accumulate(acc, num1, num2, false);
+}
+
+/**
+ * @brief fused multiply-subtract, acc -= num1 * num2 without materialising the product
+ *
+ * @param acc the accumulator
+ * @param num1 a view, which may refer to acc
+ * @param num2 a view, which may refer to acc
+ */
+void fms(bigint &acc, bigint_view num1, bigint_view num2)
+{
+    BIGINT_COUNT_OP(bigint_op::multiply);
+    BIGINT_COUNT_ALGORITHM(bigint_algorithm::addmul, std::max(num1.size(), num2.size()));
+    bigint::multiply_accumulate(acc, num1, num2, true);
+}
+
+/**
+ * @brief a helper function to square a number
+ *
+ * Long multiplication is used below bigint_active_thresholds.karatsuba_square limbs and
+ * Karatsuba's method above, see sqr_limbs.
+ *
+ * @param num a trimmed view whose sign is ignored
+ * @return bigint the square of num
+ */
+bigint bigint::square(bigint_view num)
+{
+    BIGINT_COUNT_OP(bigint_op::multiply);
+    BIGINT_COUNT_ALGORITHM(num.size() < bigint_threshold(&bigint_thresholds::karatsuba_square) ? bigint_algorithm::sqr_schoolbook
+                                                                                               : bigint_algorithm::sqr_karatsuba,
+                           num.size());
+    bigint result;
+    result.limbs.resize(2 * num.size());
+    if (num.size() <= bigint_small_limbs)
+    {
+        bigint_mul_small[num.size() - 1][num.size() - 1](result.limbs.data(), num.limbs().data(), num.limbs().data());
+    }
+    else
+    {
+        sqr_limbs(result.limbs.data(), num.limbs().data(), num.size());
+    }
+    result.trim();
+    return result;
+}
+
+/**
+ * @brief a helper function to square a limb array, with Karatsuba's method for large operands
+ *
+ * Below the threshold every cross product a[i] * a[j] with i < j appears twice in the square,
+ * so it is computed once, the sum is doubled with a one-bit shift, and the diagonal products
+ * a[i]^2 are added, about half the limb multiplications of long multiplication. Above it,
+ * a = a1 * B^h + a0 gives a^2 = a1^2 * B^2h + ((a0 + a1)^2 - a0^2 - a1^2) * B^h + a0^2, three
+ * half-size squares.
+ *
+ * @param out 2n limbs, overwritten with the square, not overlapping a
+ * @param a n limbs
+ * @param n the number of limbs of a
+ */
+void bigint::sqr_limbs(bigint_limb *out, const bigint_limb *a, size_t n)
+{
+    std::fill(out, out + 2 * n, bigint_limb(0));
+    if (n >= bigint_threshold(&bigint_thresholds::karatsuba_square))
+    {
+        size_t h = (n + 1) / 2;
+        size_t n1 = n - h;
+        sqr_limbs(out, a, h);
+        sqr_limbs(out + 2 * h, a + h, n1);
+
+        bigint_scratch_frame frame;
+        bigint_limb *sum = frame.take(h + 1);
+        std::copy(a, a + h, sum);
+        sum[h] = bigint_mpn_add(sum, sum, h, a + h, n1);
+        size_t s = sum[h] != 0 ? h + 1 : h;
+        bigint_limb *middle = frame.take(2 * s);
+        sqr_limbs(middle, sum, s);
+        bigint_mpn_sub(middle, middle, 2 * s, out, 2 * h);
+        bigint_mpn_sub(middle, middle, 2 * s, out + 2 * h, 2 * n1);
+
+        // 2 * a0 * a1 fits in the limbs above h
+        bigint_mpn_add(out + h, out + h, 2 * n - h, middle, std::min(2 * s, 2 * n - h));
+        return;
+    }
+
+    // cross products
+    for (size_t i = 0; i + 1 < n; i++)
+    {
+        out[i + n] = bigint_mpn_addmul_1(out + 2 * i + 1, a + i + 1, n - i - 1, a[i]);
+    }
+
+    // double them
+    bigint_mpn_lshift(out, out, 2 * n, 1);
+
+    // add the diagonal
+    bigint_limb carry = 0;
+    for (size_t i = 0; i < n; i++)
+    {
+        bigint_double_limb t = bigint_double_limb(a[i]) * a[i];
+        bigint_double_limb low = bigint_double_limb(out[2 * i]) + bigint_limb(t) + carry;
+        out[2 * i] = bigint_limb(low);
+        bigint_double_limb upper = bigint_double_limb(out[2 * i + 1]) + bigint_limb(t >> bigint_limb_bits) +
+                                   bigint_limb(low >> bigint_limb_bits);
+        out[2 * i + 1] = bigint_limb(upper);
+        carry = bigint_limb(upper >> bigint_limb_bits);
+    }
+}
+
+/**
+ * @brief raise a number to a power with left-to-right sliding-window exponentiation
+ *
+ * The factor 2^t of the base is taken out first and applied as a single shift at the end,
+ * so a power of two costs one shift and a power of ten is a power of five and a shift.
+ * The odd part is raised by scanning the exponent from the top bit, squaring once per bit
+ * and multiplying by a precomputed odd power once per window of up to 4 bits, about
+ * log2(exp) squarings and log2(exp) / 5 multiplications.
+ *
+ * @param base a view of the base
+ * @param exp the exponent, pow(x, 0) is 1 for every x including 0
+ * @return bigint base^exp
+ */
+bigint pow(bigint_view base, uint64_t exp)
+{
+    BIGINT_COUNT_OP(bigint_op::power);
+    base = base.trimmed();
+    if (exp == 0)
+    {
+        return bigint(1);
+    }
+    if (base.is_zero())
+    {
+        return bigint();
+    }
+
+    size_t zeros = base.countr_zero();
+    if (exp > SIZE_MAX / base.bit_length())
+    {
+        throw std::length_error("pow result too large");
+    }
+    bigint odd = bigint(base.abs()) >> zeros;
+
+    bigint result;
+    if (odd.limbs.size() == 1 && odd.limbs[0] == 1)
+    {
+        result = bigint(1);
+    }
+    else
+    {
+        int bits = int(std::bit_width(exp));
+        int window = bits <= 4 ? 1 : bits <= 16 ? 2 : bits <= 40 ? 3 : 4;
+
+        // odd powers odd^1, odd^3, ..., odd^(2^window - 1)
+        std::vector<bigint> powers(size_t(1) << (window - 1));
+        powers[0] = odd;
+        if (powers.size() > 1)
+        {
+            bigint odd_squared = bigint::square(odd);
+            for (size_t i = 1; i < powers.size(); i++)
+            {
+                powers[i] = powers[i - 1] * odd_squared;
+            }
+        }
+
+        bool started = false;
+        for (int i = bits - 1; i >= 0;)
+        {
+            if (((exp >> i) & 1) == 0)
+            {
+                result = bigint::square(result);
+                i--;
+                continue;
+            }
+
+            // the longest window of at most window bits that starts at bit i and ends in a one bit
+            int low = std::max(i - window + 1, 0);
+            while (((exp >> low) & 1) == 0)
+            {
+                low++;
+            }
+            uint64_t value = (exp >> low) & ((uint64_t(1) << (i - low + 1)) - 1);
+            if (started)
+            {
+                for (int j = low; j <= i; j++)
+                {
+                    result = bigint::square(result);
+                }
+                result *= powers[value >> 1];
+            }
+            else
+            {
+                result = powers[value >> 1];
+                started = true;
+            }
+            i = low - 1;
+        }
+    }
+
+    result <<= zeros * exp;
+    result.is_negative = base.negative() && exp % 2 == 1;
+    return result;
+}
+
+/**
+ * @brief Overload the * operator to perform multiplication of two bigints using long multiplication method
+ *
+ * @param other
+ * @return bigint the result of the multiplication
+ */
+bigint bigint::operator*(const bigint &other) const
+{
+    return bigint_view(*this) * bigint_view(other);
+}
+
+/**
+ * @brief Overload the *= operator to perform multiplication of two bigints use operator*()
+ *
+ * @param other a bigint to be multiplied
+ * @return bigint the result of the multiplication
+ */
+bigint bigint::operator*=(const bigint &other)
+{
+    *this = *this * other;
+    return *this;
+}
+
+/**
+ * @brief Overload the *= operator to multiply by a view, the view may refer to this bigint
+ *
+ * @param other a view to be multiplied
+ * @return bigint the result of the multiplication
+ */
+bigint bigint::operator*=(bigint_view other)
+{
+    *this = bigint_view(*this) * other;
+    return *this;
+}
+
+/**
+ * @brief Overload the += operator to add a native integer in place
+ *
+ * @tparam T a native integer type
+ * @param num a native integer to be added
+ * @return bigint the result of the addition
+ */
+template <bigint_native_integer T>
+bigint bigint::operator+=(T num)
+{
+    BIGINT_COUNT_OP(bigint_op::add);
+    add_small(native_magnitude(num), native_negative(num));
+    return *this;
+}
+
+/**
+ * @brief Overload the + operator to add a native integer without converting it to bigint
+ *
+ * @tparam T a native integer type
+ * @param num a native integer to be added
+ * @return bigint the result of the addition
+ */
+template <bigint_native_integer T>
+bigint bigint::operator+(T num) const
+{
+    bigint result = *this;
+    result += num;
+    return result;
+}
+
+/**
+ * @brief Overload the -= operator to subtract a native integer in place
+ *
+ * @tparam T a native integer type
+ * @param num a native integer to be subtracted
+ * @return bigint the result of the subtraction
+ */
+template <bigint_native_integer T>
+bigint bigint::operator-=(T num)
+{
+    BIGINT_COUNT_OP(bigint_op::subtract);
+    add_small(native_magnitude(num), !native_negative(num));
+    return *this;
+}
+
+/**
+ * @brief Overload the - operator to subtract a native integer without converting it to bigint
+ *
+ * @tparam T a native integer type
+ * @param num a native integer to be subtracted
+ * @return bigint the result of the subtraction
+ */
+template <bigint_native_integer T>
+bigint bigint::operator-(T num) const
+{
+    bigint result = *this;
+    result -= num;
+    return result;
+}
+
+/**
+ * @brief Overload the *= operator to multiply by a native integer in one pass over the limbs
+ *
+ * @tparam T a native integer type
+ * @param num a native integer to be multiplied
+ * @return bigint the result of the multiplication
+ */
+template <bigint_native_integer T>
+bigint bigint::operator*=(T num)
+{
+    BIGINT_COUNT_OP(bigint_op::multiply);
+    BIGINT_COUNT_ALGORITHM(bigint_algorithm::mul_single_limb, limbs.size());
+    multiply_small(native_magnitude(num), native_negative(num));
+    return *this;
+}
+
+/**
+ * @brief Overload the * operator to multiply by a native integer without converting it to bigint
+ *
+ * @tparam T a native integer type
+ * @param num a native integer to be multiplied
+ * @return bigint the result of the multiplication
+ */
+template <bigint_native_integer T>
+bigint bigint::operator*(T num) const
+{
+    bigint result = *this;
+    result *= num;
+    return result;
+}
+
+/**
+ * @brief Overload the /= operator to divide by a native integer in one pass over the limbs
+ *
+ * @tparam T a native integer type
+ * @param num a non-zero native integer divisor
+ * @return bigint the quotient, truncated towards zero like the built-in operator
+ */
+template <bigint_native_integer T>
+bigint bigint::operator/=(T num)
+{
+    BIGINT_COUNT_OP(bigint_op::divide);
+    BIGINT_COUNT_ALGORITHM(bigint_algorithm::div_single_limb, limbs.size());
+    divmod_small(native_magnitude(num), native_negative(num));
+    return *this;
+}
+
+/**
+ * @brief Overload the / operator to divide by a native integer
+ *
+ * @tparam T a native integer type
+ * @param num a non-zero native integer divisor
+ * @return bigint the quotient, truncated towards zero like the built-in operator
+ */
+template <bigint_native_integer T>
+bigint bigint::operator/(T num) const
+{
+    bigint result = *this;
+    result /= num;
+    return result;
+}
+
+/**
+ * @brief Overload the %= operator to replace a bigint by its remainder
+ *
+ * @tparam T a native integer type
+ * @param num a non-zero native integer divisor
+ * @return bigint the remainder, with the sign of the dividend like the built-in operator
+ */
+template <bigint_native_integer T>
+bigint bigint::operator%=(T num)
+{
+    *this = *this % num;
+    return *this;
+}
+
+/**
+ * @brief Overload the % operator to find the remainder of a division by a native integer
+ *
+ * Only the remainder is computed, the quotient limbs are never written.
+ *
+ * @tparam T a native integer type
+ * @param num a non-zero native integer divisor
+ * @return bigint the remainder, with the sign of the dividend like the built-in operator
+ */
+template <bigint_native_integer T>
+bigint bigint::operator%(T num) const
+{
+    BIGINT_COUNT_OP(bigint_op::divide);
+    BIGINT_COUNT_ALGORITHM(bigint_algorithm::div_single_limb, limbs.size());
+    bigint_limb magnitude = native_magnitude(num);
+    if (magnitude == 0)
+    {
+        throw std::domain_error("Division by zero");
+    }
+    bigint result;
+    bigint_limb remainder = remainder_small(magnitude);
+    if (remainder != 0)
+    {
+        result.limbs.push_back(remainder);
+        result.is_negative = is_negative;
+    }
+    return result;
+}
+
+/**
+ * @brief Overload the /= operator to divide by a view
+ *
+ * @param other a non-zero divisor
+ * @return bigint the quotient, truncated towards zero
+ */
+bigint bigint::operator/=(bigint_view other)
+{
+    *this = divmod(*this, other).first;
+    return *this;
+}
+
+/**
+ * @brief Overload the %= operator to replace a bigint by its remainder after division by a view
+ *
+ * @param other a non-zero divisor
+ * @return bigint the remainder, with the sign of the dividend
+ */
+bigint bigint::operator%=(bigint_view other)
+{
+    *this = divmod(*this, other).second;
+    return *this;
+}
+
+/**
+ * @brief Overload the / operator to divide two views
+ *
+ * @param num1 the dividend
+ * @param num2 a non-zero divisor
+ * @return bigint the quotient, truncated towards zero like the built-in operator
+ */
+bigint operator/(bigint_view num1, bigint_view num2)
+{
+    return divmod(num1, num2).first;
+}
+
+/**
+ * @brief Overload the % operator to find the remainder of a division of two views
+ *
+ * @param num1 the dividend
+ * @param num2 a non-zero divisor
+ * @return bigint the remainder, with the sign of the dividend like the built-in operator
+ */
+bigint operator%(bigint_view num1, bigint_view num2)
+{
+    return divmod(num1, num2).second;
+}
+
+/**
+ * @brief divide two numbers, giving the quotient and the remainder together
+ *
+ * A single-limb divisor takes one pass over the limbs. Longer divisors use long division
+ * (Knuth's algorithm D) below bigint_active_thresholds.recursive_division limbs, and Burnikel and
+ * Ziegler's recursive division above it, which costs a few multiplications of the divisor's size.
+ *
+ * @param num1 the dividend
+ * @param num2 a non-zero divisor
+ * @return std::pair<bigint, bigint> the quotient, truncated towards zero, and the remainder, with the sign of the dividend
+ */
+std::pair<bigint, bigint> divmod(bigint_view num1, bigint_view num2)
+{
+    BIGINT_COUNT_OP(bigint_op::divide);
+    num1 = num1.trimmed();
+    num2 = num2.trimmed();
+    if (num2.size() == 0)
+    {
+        throw std::domain_error("Division by zero");
+    }
+
+    bigint quotient, remainder;
+    if (bigint::compare_magnitude(num1, num2) < 0)
+    {
+        remainder = bigint(num1);
+        return {std::move(quotient), std::move(remainder)};
+    }
+    if (num2.size() == 1)
+    {
+        BIGINT_COUNT_ALGORITHM(bigint_algorithm::div_single_limb, num1.size());
+        quotient = bigint(num1.abs());
+        bigint_limb r = quotient.divide_small(num2[0]);
+        if (r != 0)
+        {
+            remainder.limbs.push_back(r);
+        }
+    }
+    else
+    {
+        BIGINT_COUNT_ALGORITHM(num2.size() < bigint_threshold(&bigint_thresholds::recursive_division) ? bigint_algorithm::div_schoolbook
+                                                                                                      : bigint_algorithm::div_recursive,
+                               num2.size());
+        bigint::divmod_magnitudes(quotient, remainder, num1, num2);
+    }
+
+    quotient.is_negative = !quotient.limbs.empty() && (num1.negative() != num2.negative());
+    remainder.is_negative = !remainder.limbs.empty() && num1.negative();
+    return {std::move(quotient), std::move(remainder)};
+}
+
+/**
+ * @brief a helper function for the quotient and remainder of two magnitudes
+ *
+ * The dividend is copied to the scratch arena, where div_limbs replaces it with the remainder,
+ * so the only allocations are the limbs of the results.
+ *
+ * @param quotient set to |num1| / |num2|
+ * @param remainder set to |num1| mod |num2|
+ * @param num1 a trimmed dividend no shorter than the divisor, its sign is ignored
+ * @param num2 a trimmed divisor of at least 2 limbs, its sign is ignored
+ */
+void bigint::divmod_magnitudes(bigint &quotient, bigint &remainder, bigint_view num1, bigint_view num2)
+{
+    size_t n = num1.size();
+    size_t m = num2.size();
+    bigint_scratch_frame frame;
+    bigint_limb *u = frame.take(n);
+    std::copy(num1.limbs().begin(), num1.limbs().end(), u);
+    quotient.limbs.resize(n - m + 1);
+    div_limbs(quotient.limbs.data(), u, n, num2.limbs().data(), m);
+    remainder.limbs.assign(u, u + m);
+    quotient.is_negative = false;
+    remainder.is_negative = false;
+    quotient.trim();
+    remainder.trim();
+}
+
+/**
+ * @brief a helper function to divide limb arrays, leaving the remainder in place of the dividend
+ *
+ * The divisor and the dividend are shifted in the scratch arena so that the divisor's top bit is
+ * set, which the quotient estimates of both division algorithms rely on, and the remainder is
+ * shifted back at the end.
+ *
+ * @param q n - m + 1 limbs, overwritten with the quotient
+ * @param u n limbs of the dividend, overwritten with the remainder in the low m limbs and zeros above
+ * @param n the number of limbs of u, n >= m
+ * @param d m limbs of the divisor, the top one not zero, not overlapping q or u
+ * @param m the number of limbs of d, m > 0
+ */
+void bigint::div_limbs(bigint_limb *q, bigint_limb *u, size_t n, const bigint_limb *d, size_t m)
+{
+    if (m == 1)
+    {
+        bigint_double_limb remainder = 0;
+        for (size_t i = n; i > 0; i--)
+        {
+            remainder = (remainder << bigint_limb_bits) | u[i - 1];
+            q[i - 1] = bigint_limb(remainder / d[0]);
+            remainder %= d[0];
+            u[i - 1] = 0;
+        }
+        u[0] = bigint_limb(remainder);
+        return;
+    }
+
+    unsigned shift = unsigned(std::countl_zero(d[m - 1]));
+    bigint_scratch_frame frame;
+    bigint_limb *nd = frame.take(m);
+    bigint_limb *nu = frame.take(n + 1);
+    if (shift == 0)
+    {
+        std::copy(d, d + m, nd);
+        std::copy(u, u + n, nu);
+        nu[n] = 0;
+    }
+    else
+    {
+        bigint_mpn_lshift(nd, d, m, shift);
+        nu[n] = bigint_mpn_lshift(nu, u, n, shift);
+    }
+
+    // the extra top limb is below 2^shift, so the top m limbs of nu are below nd and q[n - m + 1] would be 0
+    div_normalised(q, nu, n + 1, nd, m);
+
+    // the remainder is below nd, so it fits in the low m limbs of nu and shifts down within them
+    if (shift == 0)
+    {
+        std::copy(nu, nu + m, u);
+    }
+    else
+    {
+        bigint_mpn_rshift(u, nu, m, shift);
+    }
+    std::fill(u + m, u + n, bigint_limb(0));
+}
+
+/**
+ * @brief a helper function to divide by a normalised divisor, long division or recursive by its size
+ *
+ * Below bigint_active_thresholds.recursive_division limbs of divisor this is long division.
+ * Above it the quotient is found in blocks of m limbs from the top, each a 2m-by-m division by
+ * div_2n_1n on the partial remainder and the next m limbs of the dividend. A top block of
+ * k < m limbs divides the top 2k limbs by the top k limbs of the divisor and corrects the
+ * estimate with one multiplication by the rest, as each half of div_2n_1n does.
+ *
+ * @param q n - m limbs, overwritten with the quotient below B^(n - m)
+ * @param u n limbs of the dividend, overwritten with the remainder in the low m limbs and zeros above
+ * @param n the number of limbs of u, n >= m
+ * @param d m limbs of the divisor with the top bit set, not overlapping q or u
+ * @param m the number of limbs of d, m >= 2
+ * @return bigint_limb the top quotient limb, 1 if the top m limbs of u were at least d, 0 otherwise
+ */
+bigint_limb bigint::div_normalised(bigint_limb *q, bigint_limb *u, size_t n, const bigint_limb *d, size_t m)
+{
+    if (m < bigint_threshold(&bigint_thresholds::recursive_division))
+    {
+        return div_basecase(q, u, n, d, m);
+    }
+
+    size_t qn = n - m;
+    size_t k = qn % m;
+    bigint_limb qh = 0;
+    if (k >= bigint_threshold(&bigint_thresholds::recursive_division))
+    {
+        size_t rest = m - k;
+        qh = div_2n_1n(q + qn - k, u + n - 2 * k, d + rest, k);
+        bigint_scratch_frame frame;
+        bigint_limb *product = frame.take(m);
+        mul_limbs(product, q + qn - k, k, d, rest);
+        bigint_limb borrow = bigint_mpn_sub(u + qn - k, u + qn - k, m, product, m);
+        if (qh != 0)
+        {
+            borrow += bigint_mpn_sub(u + qn, u + qn, rest, d, rest);
+        }
+        const bigint_limb one = 1;
+        while (borrow != 0)
+        {
+            qh -= bigint_mpn_sub(q + qn - k, q + qn - k, k, &one, 1);
+            borrow -= bigint_mpn_add(u + qn - k, u + qn - k, m, d, m);
+        }
+    }
+    else if (k > 0)
+    {
+        qh = div_basecase(q + qn - k, u + qn - k, m + k, d, m);
+    }
+
+    // after the top block the top m limbs of each window are a remainder below d, so only the first can have a top quotient limb
+    for (size_t j = qn - k; j > 0; j -= m)
+    {
+        qh += div_2n_1n(q + j - m, u + j - m, d, m);
+    }
+    return qh;
+}
+
+/**
+ * @brief a helper function for long division by a normalised divisor (Knuth's algorithm D)
+ *
+ * Each quotient limb is estimated from the top two limbs of the remainder and the top limb of
+ * the divisor, corrected with the second limb of the divisor, and is at most one too large
+ * after that, which a final add-back fixes.
+ *
+ * @param q n - m limbs, overwritten with the quotient below B^(n - m)
+ * @param u n limbs of the dividend, overwritten with the remainder in the low m limbs and zeros above
+ * @param n the number of limbs of u, n >= m
+ * @param d m limbs of the divisor with the top bit set, not overlapping q or u
+ * @param m the number of limbs of d, m >= 2
+ * @return bigint_limb the top quotient limb, 1 if the top m limbs of u were at least d, 0 otherwise
+ */
+bigint_limb bigint::div_basecase(bigint_limb *q, bigint_limb *u, size_t n, const bigint_limb *d, size_t m)
+{
+    // with the top bit of d set, the top m limbs of u hold d at most once
+    bigint_limb qh = bigint_mpn_cmp(u + n - m, d, m) >= 0 ? 1 : 0;
+    if (qh != 0)
+    {
+        bigint_mpn_sub_n(u + n - m, u + n - m, d, m);
+    }
+
+    constexpr bigint_double_limb base = bigint_double_limb(1) << bigint_limb_bits;
+    for (size_t j = n - m; j > 0; j--)
+    {
+        bigint_limb *window = u + j - 1; // m + 1 limbs
+        bigint_double_limb top = (bigint_double_limb(window[m]) << bigint_limb_bits) | window[m - 1];
+        bigint_double_limb estimate = top / d[m - 1];
+        bigint_double_limb rest = top % d[m - 1];
+        while (estimate >= base || estimate * d[m - 2] > ((rest << bigint_limb_bits) | window[m - 2]))
+        {
+            estimate--;
+            rest += d[m - 1];
+            if (rest >= base)
+            {
+                break;
+            }
+        }
+
+        bigint_limb digit = bigint_limb(estimate);
+        bigint_limb borrow = bigint_mpn_submul_1(window, d, m, digit);
+        bool negative = window[m] < borrow;
+        window[m] -= borrow;
+        if (negative)
+        {
+            digit--;
+            window[m] += bigint_mpn_add_n(window, window, d, m);
+        }
+        q[j - 1] = digit;
+    }
+    return qh;
+}
+
+/**
+ * @brief a helper function to divide 2n limbs by n limbs recursively (Burnikel and Ziegler)
+ *
+ * The quotient is found in two halves. Each half divides the top limbs of the partial remainder
+ * by the top half of the divisor recursively, then subtracts the estimate times the low half of
+ * the divisor and adds the divisor back while the remainder is negative, at most twice. Every
+ * temporary is a product of n limbs in the scratch arena.
+ *
+ * @param q n limbs, overwritten with the quotient below B^n
+ * @param u 2n limbs of the dividend, overwritten with the remainder in the low n limbs and zeros above
+ * @param d n limbs of the divisor with the top bit set, not overlapping q or u
+ * @param n the number of limbs of d
+ * @return bigint_limb the top quotient limb, 1 if the top n limbs of u were at least d, 0 otherwise
+ */
+bigint_limb bigint::div_2n_1n(bigint_limb *q, bigint_limb *u, const bigint_limb *d, size_t n)
+{
+    if (n < bigint_threshold(&bigint_thresholds::recursive_division))
+    {
+        return div_basecase(q, u, 2 * n, d, n);
+    }
+    size_t lo = n / 2;
+    size_t hi = n - lo;
+    const bigint_limb one = 1;
+    bigint_scratch_frame frame;
+    bigint_limb *product = frame.take(n);
+
+    // high half: the top 2hi limbs by the top hi limbs of d, then the rest of d times the estimate
+    bigint_limb qh = div_2n_1n(q + lo, u + 2 * lo, d + lo, hi);
+    mul_limbs(product, q + lo, hi, d, lo);
+    bigint_limb borrow = bigint_mpn_sub(u + lo, u + lo, n, product, n);
+    if (qh != 0)
+    {
+        borrow += bigint_mpn_sub(u + n, u + n, lo, d, lo);
+    }
+    while (borrow != 0)
+    {
+        qh -= bigint_mpn_sub(q + lo, q + lo, hi, &one, 1);
+        borrow -= bigint_mpn_add(u + lo, u + lo, n, d, n);
+    }
+
+    // low half: the partial remainder's top 2lo limbs by the top lo limbs of d; a carry out of
+    // the estimate is always taken back by the correction, since the true quotient fits
+    bigint_limb ql = div_2n_1n(q, u + hi, d + hi, lo);
+    mul_limbs(product, d, hi, q, lo);
+    borrow = bigint_mpn_sub(u, u, n, product, n);
+    if (ql != 0)
+    {
+        borrow += bigint_mpn_sub(u + lo, u + lo, hi, d, hi);
+    }
+    while (borrow != 0)
+    {
+        bigint_mpn_sub(q, q, lo, &one, 1);
+        borrow -= bigint_mpn_add(u, u, n, d, n);
+    }
+    return qh;
+}
+
+/**
+ * @brief the greatest common divisor of two numbers with Euclid's algorithm
+ *
+ * Both numbers are copied to the scratch arena and each step leaves the remainder in place of
+ * the larger one, so only the result is allocated.
+ *
+ * @param num1 a number
+ * @param num2 a number
+ * @return bigint the non-negative greatest common divisor, 0 if both are 0
+ */
+bigint gcd(bigint_view num1, bigint_view num2)
+{
+    num1 = num1.trimmed();
+    num2 = num2.trimmed();
+    if (bigint::compare_magnitude(num1, num2) < 0)
+    {
+        std::swap(num1, num2);
+    }
+    if (num2.size() == 0)
+    {
+        return bigint(num1.abs());
+    }
+
+    bigint_scratch_frame frame;
+    size_t an = num1.size();
+    size_t bn = num2.size();
+    bigint_limb *a = frame.take(an);
+    bigint_limb *b = frame.take(bn);
+    bigint_limb *q = frame.take(an);
+    std::copy(num1.limbs().begin(), num1.limbs().end(), a);
+    std::copy(num2.limbs().begin(), num2.limbs().end(), b);
+    while (bn > 1)
+    {
+        bigint::div_limbs(q, a, an, b, bn);
+        an = bn;
+        while (an > 0 && a[an - 1] == 0)
+        {
+            an--;
+        }
+        std::swap(a, b);
+        std::swap(an, bn);
+    }
+
+    bigint result;
+    if (bn == 0)
+    {
+        result.limbs.assign(a, a + an);
+        return result;
+    }
+    bigint::div_limbs(q, a, an, b, 1);
+    bigint_limb g = std::gcd(b[0], a[0]);
+    result.limbs.push_back(g);
+    return result;
+}
+
+/**
+ * @brief Overload the + operator to add a bigint to a native integer
+ *
+ * @tparam T a native integer type
+ * @param num1 a native integer
+ * @param num2 a bigint
+ * @return bigint the result of the addition
+ */
+template <bigint_native_integer T>
+bigint operator+(T num1, const bigint &num2)
+{
+    return num2 + num1;
+}
+
+/**
+ * @brief Overload the - operator to subtract a bigint from a native integer
+ *
+ * @tparam T a native integer type
+ * @param num1 a native integer
+ * @param num2 a bigint
+ * @return bigint the result of the subtraction
+ */
+template <bigint_native_integer T>
+bigint operator-(T num1, const bigint &num2)
+{
+    return -num2 + num1;
+}
+
+/**
+ * @brief Overload the * operator to multiply a native integer by a bigint
+ *
+ * @tparam T a native integer type
+ * @param num1 a native integer
+ * @param num2 a bigint
+ * @return bigint the result of the multiplication
+ */
+template <bigint_native_integer T>
+bigint operator*(T num1, const bigint &num2)
+{
+    return num2 * num1;
+}
+
+/**
+ * @brief Overload the - operator to negate a bigint
+ *
+ * @return bigint the negated bigint
+ */
+bigint bigint::operator-() const
+{
+    bigint result = *this;
+    result.is_negative = !is_negative;
+    result.trim();
+    return result;
+}
+
+/**
+ * @brief Overload the & operator to perform bitwise and of two views in two's complement
+ *
+ * @param num1 a view
+ * @param num2 a view
+ * @return bigint the result of the bitwise and
+ */
+bigint operator&(bigint_view num1, bigint_view num2)
+{
+    BIGINT_COUNT_OP(bigint_op::bitwise);
+    return bigint::bitwise(num1, num2, [](bigint_limb a, bigint_limb b)
+                           { return a & b; });
+}
+
+/**
+ * @brief Overload the | operator to perform bitwise or of two views in two's complement
+ *
+ * @param num1 a view
+ * @param num2 a view
+ * @return bigint the result of the bitwise or
+ */
+bigint operator|(bigint_view num1, bigint_view num2)
+{
+    BIGINT_COUNT_OP(bigint_op::bitwise);
+    return bigint::bitwise(num1, num2, [](bigint_limb a, bigint_limb b)
+                           { return a | b; });
+}
+
+/**
+ * @brief Overload the ^ operator to perform bitwise xor of two views in two's complement
+ *
+ * @param num1 a view
+ * @param num2 a view
+ * @return bigint the result of the bitwise xor
+ */
+bigint operator^(bigint_view num1, bigint_view num2)
+{
+    BIGINT_COUNT_OP(bigint_op::bitwise);
+    return bigint::bitwise(num1, num2, [](bigint_limb a, bigint_limb b)
+                           { return a ^ b; });
+}
+
+/**
+ * @brief Overload the ~ operator to perform bitwise not of a view, ~x = -x - 1 = -(x + 1)
+ *
+ * @param num a view
+ * @return bigint the result of the bitwise not
+ */
+bigint operator~(bigint_view num)
+{
+    BIGINT_COUNT_OP(bigint_op::bitwise);
+    const bigint_limb one[] = {1};
+    bigint result = num.negative() && !num.is_zero() ? bigint::subtract(num, bigint_view(one)) // ~(-y) = y - 1
+                                                     : bigint::add(num, bigint_view(one));     // ~y = -(y + 1)
+    result.is_negative = !(num.negative() && !num.is_zero());
+    result.trim();
+    return result;
+}
+
+/**
+ * @brief Overload the << operator to multiply a view by 2^shift, moving whole limbs and then bits
+ *
+ * @param num a view
+ * @param shift the number of bits to shift by
+ * @return bigint the shifted value
+ */
+bigint operator<<(bigint_view num, size_t shift)
+{
+    BIGINT_COUNT_OP(bigint_op::shift);
+    bigint result;
+    num = num.trimmed();
+    if (num.size() == 0)
+    {
+        return result;
+    }
+
+    size_t limb_shift = shift / bigint_limb_bits;
+    unsigned bit_shift = unsigned(shift % bigint_limb_bits);
+    result.limbs.assign(limb_shift + num.size() + 1, 0);
+    if (bit_shift == 0)
+    {
+        std::copy(num.limbs().begin(), num.limbs().end(), result.limbs.begin() + std::ptrdiff_t(limb_shift));
+    }
+    else
+    {
+        result.limbs[limb_shift + num.size()] = bigint_mpn_lshift(result.limbs.data() + limb_shift, num.limbs().data(), num.size(), bit_shift);
+    }
+
+    result.is_negative = num.negative();
+    result.trim();
+    return result;
+}
+
+/**
+ * @brief Overload the >> operator to divide a view by 2^shift, rounding towards negative infinity
+ *
+ * This matches an arithmetic shift of the two's complement representation.
+ *
+ * @param num a view
+ * @param shift the number of bits to shift by
+ * @return bigint the shifted value
+ */
+bigint operator>>(bigint_view num, size_t shift)
+{
+    BIGINT_COUNT_OP(bigint_op::shift);
+    bigint result;
+    num = num.trimmed();
+    size_t limb_shift = shift / bigint_limb_bits;
+    unsigned bit_shift = unsigned(shift % bigint_limb_bits);
+
+    // a negative number that loses set bits rounds down, away from zero
+    bool round_down = num.negative() && num.size() > 0 && num.countr_zero() < shift;
+
+    if (limb_shift < num.size())
+    {
+        result.limbs.resize(num.size() - limb_shift);
+        if (bit_shift == 0)
+        {
+            std::copy(num.limbs().begin() + std::ptrdiff_t(limb_shift), num.limbs().end(), result.limbs.begin());
+        }
+        else
+        {
+            bigint_mpn_rshift(result.limbs.data(), num.limbs().data() + limb_shift, result.limbs.size(), bit_shift);
+        }
+    }
+    result.trim();
+
+    if (round_down)
+    {
+        const bigint_limb one[] = {1};
+        result = bigint::add(result, bigint_view(one));
+    }
+    result.is_negative = num.negative();
+    result.trim();
+    return result;
+}
+
+/**
+ * @brief Overload the & operator to perform bitwise and of two bigints
+ *
+ * @param other a bigint
+ * @return bigint the result of the bitwise and
+ */
+bigint bigint::operator&(const bigint &other) const
+{
+    return bigint_view(*this) & bigint_view(other);
+}
+
+/**
+ * @brief Overload the &= operator to perform bitwise and of two bigints use operator&()
+ *
+ * @param other a bigint
+ * @return bigint the result of the bitwise and
+ */
+bigint bigint::operator&=(const bigint &other)
+{
+    *this = *this & other;
+    return *this;
+}
+
+/**
+ * @brief Overload the | operator to perform bitwise or of two bigints
+ *
+ * @param other a bigint
+ * @return bigint the result of the bitwise or
+ */
+bigint bigint::operator|(const bigint &other) const
+{
+    return bigint_view(*this) | bigint_view(other);
+}
+
+/**
+ * @brief Overload the |= operator to perform bitwise or of two bigints use operator|()
+ *
+ * @param other a bigint
+ * @return bigint the result of the bitwise or
+ */
+bigint bigint::operator|=(const bigint &other)
+{
+    *this = *this | other;
+    return *this;
+}
+
+/**
+ * @brief Overload the ^ operator to perform bitwise xor of two bigints
+ *
+ * @param other a bigint
+ * @return bigint the result of the bitwise xor
+ */
+bigint bigint::operator^(const bigint &other) const
+{
+    return bigint_view(*this) ^ bigint_view(other);
+}
+
+/**
+ * @brief Overload the ^= operator to perform bitwise xor of two bigints use operator^()
+ *
+ * @param other a bigint
+ * @return bigint the result of the bitwise xor
+ */
+bigint bigint::operator^=(const bigint &other)
+{
+    *this = *this ^ other;
+    return *this;
+}
+
+/**
+ * @brief Overload the ~ operator to perform bitwise not of a bigint
+ *
+ * @return bigint the result of the bitwise not, -x - 1
+ */
+bigint bigint::operator~() const
+{
+    return ~bigint_view(*this);
+}
+
+/**
+ * @brief Overload the << operator to multiply a bigint by 2^shift
+ *
+ * @param shift the number of bits to shift by
+ * @return bigint the shifted value
+ */
+bigint bigint::operator<<(size_t shift) const
+{
+    return bigint_view(*this) << shift;
+}
+
+/**
+ * @brief Overload the <<= operator to multiply a bigint by 2^shift use operator<<()
+ *
+ * @param shift the number of bits to shift by
+ * @return bigint the shifted value
+ */
+bigint bigint::operator<<=(size_t shift)
+{
+    *this = *this << shift;
+    return *this;
+}
+
+/**
+ * @brief Overload the >> operator to divide a bigint by 2^shift, rounding towards negative infinity
+ *
+ * @param shift the number of bits to shift by
+ * @return bigint the shifted value
+ */
+bigint bigint::operator>>(size_t shift) const
+{
+    return bigint_view(*this) >> shift;
+}
+
+/**
+ * @brief Overload the >>= operator to divide a bigint by 2^shift use operator>>()
+ *
+ * @param shift the number of bits to shift by
+ * @return bigint the shifted value
+ */
+bigint bigint::operator>>=(size_t shift)
+{
+    *this = *this >> shift;
+    return *this;
+}
+
+/**
+ * @brief the number of bits needed for the absolute value
+ *
+ * @return size_t the position of the highest set bit plus one, 0 for zero
+ */
+size_t bigint::bit_length() const
+{
+    return bigint_view(*this).bit_length();
+}
+
+/**
+ * @brief the number of set bits in the absolute value
+ *
+ * @return size_t the number of ones
+ */
+size_t bigint::popcount() const
+{
+    return bigint_view(*this).popcount();
+}
+
+/**
+ * @brief the number of trailing zero bits
+ *
+ * @return size_t the position of the lowest set bit, 0 for zero
+ */
+size_t bigint::countr_zero() const
+{
+    return bigint_view(*this).countr_zero();
+}
+
+/**
+ * @brief Overload the == operator to compare two views
+ *
+ * @param num1 a view to be compared
+ * @param num2 a view to be compared
+ * @return true if the two views have the same value
+ * @return false if the two views have different values
+ */
+bool operator==(bigint_view num1, bigint_view num2)
+{
+    BIGINT_COUNT_OP(bigint_op::compare);
+    if (bigint::compare_magnitude(num1, num2) != 0)
+    {
+        return false;
+    }
+    return num1.negative() == num2.negative() || num1.is_zero(); // zero has no sign
+}
+
+/**
+ * @brief Overload the != operator to compare two views
+ *
+ * @param num1 a view to be compared
+ * @param num2 a view to be compared
+ * @return true if the two views have different values
+ * @return false if the two views have the same value
+ */
+bool operator!=(bigint_view num1, bigint_view num2)
+{
+    return !(num1 == num2);
+}
+
+/**
+ * @brief Overload the < operator to compare two views
+ *
+ * @param num1 a view to be compared
+ * @param num2 a view to be compared
+ * @return true if num1 is smaller than num2
+ * @return false if num1 is larger than or equal to num2
+ */
+bool operator<(bigint_view num1, bigint_view num2)
+{
+    return bigint::is_smaller(num1, num2);
+}
+
+/**
+ * @brief Overload the <= operator to compare two views
+ *
+ * @param num1 a view to be compared
+ * @param num2 a view to be compared
+ * @return true if num1 is smaller than or equal to num2
+ * @return false if num1 is larger than num2
+ */
+bool operator<=(bigint_view num1, bigint_view num2)
+{
+    return !(num2 < num1);
+}
+
+/**
+ * @brief Overload the > operator to compare two views
+ *
+ * @param num1 a view to be compared
+ * @param num2 a view to be compared
+ * @return true if num1 is larger than num2
+ * @return false if num1 is smaller than or equal to num2
+ */
+bool operator>(bigint_view num1, bigint_view num2)
+{
+    return num2 < num1;
+}
+
+/**
+ * @brief Overload the >= operator to compare two views
+ *
+ * @param num1 a view to be compared
+ * @param num2 a view to be compared
+ * @return true if num1 is larger than or equal to num2
+ * @return false if num1 is smaller than num2
+ */
+bool operator>=(bigint_view num1, bigint_view num2)
+{
+    return !(num1 < num2);
+}
+
+/**
+ * @brief Overload the == operator to compare two bigints
+ *
+ * @param other a bigint to be compared
+ * @return true if the two bigints are equal
+ * @return false if the two bigints are not equal
+ */
+bool bigint::operator==(const bigint &other) const
+{
+    return bigint_view(*this) == bigint_view(other);
+}
+
+/**
+ * @brief Overload the != operator to compare two bigints
+ *
+ * @param other a bigint to be compared
+ * @return true if the two bigints are not equal
+ * @return false if the two bigints are equal
+ */
+bool bigint::operator!=(const bigint &other) const
+{
+    return !(*this == other);
+}
+
+/**
+ * @brief Overload the < operator to compare two bigints
+ *
+ * @param other a bigint to be compared
+ * @return true if the first bigint is smaller than the second bigint
+ * @return false if the first bigint is larger than the second bigint
+ */
+bool bigint::operator<(const bigint &other) const
+{
+    return is_smaller(*this, other);
+}
+
+/**
+ * @brief Overload the <= operator to compare two bigints
+ *
+ * @param other a bigint to be compared
+ * @return true if the first bigint is smaller than or equal to the second bigint
+ * @return false if the first bigint is larger than the second bigint
+ */
+bool bigint::operator<=(const bigint &other) const
+{
+    return !is_smaller(other, *this);
+}
+
+/**
+ * @brief Overload the > operator to compare two bigints
+ *
+ * @param other a bigint to be compared
+ * @return true if the first bigint is larger than the second bigint
+ * @return false if the first bigint is smaller than the second bigint
+ */
+bool bigint::operator>(const bigint &other) const
+{
+    return is_smaller(other, *this);
+}
+
+/**
+ * @brief Overload the >= operator to compare two bigints
+ *
+ * @param other a bigint to be compared
+ * @return true if the first bigint is larger than or equal to the second bigint
+ * @return false if the first bigint is smaller than the second bigint
+ */
+bool bigint::operator>=(const bigint &other) const
+{
+    return !is_smaller(*this, other);
+}
+
+/**
+ * @brief Overload the << operator to print a bigint to an output stream
  *
  * @param os an output stream
  * @param num a bigint to be inserted
@@ -592,25 +2723,258 @@ bool bigint::operator>=(const bigint &other) const
  */
 std::ostream &operator<<(std::ostream &os, const bigint &num)
 {
-    if (num.is_negative)
+    return os << num.to_string();
+}
+
+/**
+ * @brief a helper function for the number of bits per digit of a power-of-two radix
+ *
+ * @param radix 2, 4, 8, 16 or 32
+ * @return int log2(radix)
+ */
+int bigint::radix_bits(unsigned radix)
+{
+    if (radix < 2 || radix > 32 || !std::has_single_bit(radix))
+    {
+        throw std::invalid_argument("Unsupported radix: " + std::to_string(radix));
+    }
+    return std::countr_zero(radix);
+}
+
+/**
+ * @brief parse a number written in radix 10 or in a power-of-two radix
+ *
+ * A power-of-two radix packs each digit's bits straight into the limbs, starting from the last
+ * digit, so the conversion takes O(n) time with no multiplication. Digits above 9 are letters
+ * in either case, and an optional '-' sign may come first.
+ *
+ * @param str the digits
+ * @param radix 10, or 2, 4, 8, 16 or 32
+ * @return bigint the value of the digits
+ */
+bigint bigint::from_string(std::string_view str, unsigned radix)
+{
+    if (radix == 10)
+    {
+        return bigint(std::string(str));
+    }
+    int bits = radix_bits(radix);
+    BIGINT_COUNT_OP(bigint_op::parse);
+    if (str.empty())
+    {
+        throw std::invalid_argument("Input String is Empty");
+    }
+    bigint result;
+    result.is_negative = str[0] == '-';
+    size_t first = result.is_negative ? 1 : 0;
+    if (first == str.size())
+    {
+        throw std::invalid_argument("Invalid argument: " + std::string(str));
+    }
+
+    result.limbs.reserve(((str.size() - first) * size_t(bits) + bigint_limb_bits - 1) / bigint_limb_bits);
+    bigint_limb limb = 0;
+    int filled = 0; // bits of limb already set
+    for (size_t i = str.size(); i > first; i--)
+    {
+        bigint_limb digit = bigint_radix_values[static_cast<unsigned char>(str[i - 1])];
+        if (digit >= radix)
+        {
+            throw std::invalid_argument("Invalid argument: " + std::string(str));
+        }
+        limb |= digit << filled;
+        filled += bits;
+        if (filled >= bigint_limb_bits)
+        {
+            // an octal digit can straddle two limbs
+            result.limbs.push_back(limb);
+            filled -= bigint_limb_bits;
+            limb = filled == 0 ? 0 : digit >> (bits - filled);
+        }
+    }
+    if (filled > 0)
+    {
+        result.limbs.push_back(limb);
+    }
+    result.trim();
+    return result;
+}
+
+/**
+ * @brief parse a number written in hexadecimal
+ *
+ * @param str hexadecimal digits in either case, with an optional '-' sign and no 0x prefix
+ * @return bigint the value of the digits
+ */
+bigint bigint::from_hex(std::string_view str)
+{
+    return from_string(str, 16);
+}
+
+/**
+ * @brief write the number in radix 10 or in a power-of-two radix
+ *
+ * In a power-of-two radix each digit is a group of bits extracted from the limbs, in O(n) time,
+ * and hexadecimal writes whole limbs 16 digits at a time with a word-parallel kernel. Decimal
+ * output divides by 10^19 repeatedly below bigint_active_thresholds.recursive_conversion limbs,
+ * and above it format_recursive splits the number by powers of 10 of half its size.
+ *
+ * @param radix 10, or 2, 4, 8, 16 or 32
+ * @return std::string the digits in lowercase, with a '-' sign if negative and no prefix
+ */
+std::string bigint::to_string(unsigned radix) const
+{
+    if (radix != 10)
     {
-        os << '-';
+        int bits = radix_bits(radix);
+        BIGINT_COUNT_OP(bigint_op::print);
+        if (limbs.empty())
+        {
+            return "0";
+        }
+        size_t digits = (bit_length() + size_t(bits) - 1) / size_t(bits);
+        std::string str(digits + (is_negative ? 1 : 0), '-');
+        char *end = str.data() + str.size(); // digits are written from the least significant
+        if (radix == 16)
+        {
+            for (size_t i = 0; i + 1 < limbs.size(); i++)
+            {
+                bigint_format_16_hex(limbs[i], end - 16 * (i + 1));
+            }
+            char top[16];
+            bigint_format_16_hex(limbs.back(), top);
+            size_t top_digits = digits - 16 * (limbs.size() - 1);
+            std::copy(top + 16 - top_digits, top + 16, end - digits);
+            return str;
+        }
+        for (size_t d = 0; d < digits; d++)
+        {
+            size_t bit = d * size_t(bits);
+            size_t index = bit / bigint_limb_bits;
+            size_t offset = bit % bigint_limb_bits;
+            bigint_limb value = limbs[index] >> offset;
+            if (offset + size_t(bits) > bigint_limb_bits && index + 1 < limbs.size())
+            {
+                value |= limbs[index + 1] << (bigint_limb_bits - offset);
+            }
+            *(end - 1 - d) = bigint_radix_chars[value & (radix - 1)];
+        }
+        return str;
     }
-    if (num.digits.size() == 1 && num.digits[0] == 0)
+
+    BIGINT_COUNT_OP(bigint_op::print);
+    std::string str;
+    append_decimal(*this, str);
+    return str;
+}
+
+/**
+ * @brief a helper function to append a number in decimal to a string
+ *
+ * @param num a trimmed view
+ * @param str the string to append the digits to, with a '-' sign if num is negative
+ */
+void bigint::append_decimal(bigint_view num, std::string &str)
+{
+    constexpr size_t chunk_digits = decimal_chunk_digits;
+
+    // an upper bound on the number of digits, log10(2) < 0.30103
+    size_t digits = num.bit_length() * 30103 / 100000 + 1;
+    size_t start = str.size();
+    bigint_scratch_frame frame;
+    bigint_limb *limbs = frame.take(num.size());
+    std::copy(num.limbs().begin(), num.limbs().end(), limbs);
+    if (num.size() < bigint_threshold(&bigint_thresholds::recursive_conversion))
     {
-        os << '0';
-        return os;
+        str.resize(start + 1 + (digits / chunk_digits + 1) * chunk_digits, '-');
+        format_chunks(limbs, num.size(), digits / chunk_digits + 1, str.data() + start + 1);
     }
     else
     {
-        for (size_t i = num.digits.size(); i > 0; i--)
+        BIGINT_COUNT_ALGORITHM(bigint_algorithm::dec_recursive, num.size());
+        size_t levels = decimal_levels(digits);
+        str.resize(start + 1 + (chunk_digits << levels), '-');
+        format_recursive(limbs, num.size(), decimal_powers(levels), levels - 1, str.data() + start + 1);
+    }
+
+    // Remove leading zeros, keeping the sign in front of the first digit
+    size_t first = std::min(str.find_first_not_of('0', start + 1), str.size() - 1);
+    if (num.negative() && !num.is_zero())
+    {
+        str[--first] = '-';
+    }
+    str.erase(start, first - start);
+}
 
+/**
+ * @brief a helper function to write a non-negative number as zero-padded decimal digits, 19 at a time
+ *
+ * The number is divided by 10^19 in place repeatedly and each remainder is written with the
+ * word-parallel kernel in bigint_digits.hpp, from the last chunk to the first.
+ *
+ * @param num n limbs of a number below 10^(19 * chunks), overwritten
+ * @param n the number of limbs of num
+ * @param chunks the number of 19-digit chunks to write
+ * @param out room for 19 * chunks characters
+ */
+void bigint::format_chunks(bigint_limb *num, size_t n, size_t chunks, char *out)
+{
+    constexpr bigint_limb chunk = 10000000000000000000ULL; // 10^19, the largest power of 10 in a limb
+    for (size_t i = chunks; i > 0; i--)
+    {
+        while (n > 0 && num[n - 1] == 0)
+        {
+            n--;
+        }
+        bigint_double_limb remainder = 0;
+        for (size_t j = n; j > 0; j--)
         {
-            os << std::to_string(num.digits[i - 1]);
+            remainder = (remainder << bigint_limb_bits) | num[j - 1];
+            num[j - 1] = bigint_limb(remainder / chunk);
+            remainder %= chunk;
         }
+        bigint_format_19_digits(bigint_limb(remainder), out + (i - 1) * decimal_chunk_digits);
     }
+}
 
-    return os;
+/**
+ * @brief a helper function to write a non-negative number as zero-padded decimal digits by divide and conquer
+ *
+ * Dividing by 10^(19 * 2^level) gives the digits of the top half as the quotient and those of
+ * the bottom half as the remainder, each written recursively, so with recursive division the
+ * whole conversion costs a few multiplications of the number's size. The division happens in
+ * place and the quotient goes to the scratch arena.
+ *
+ * @param num n limbs of a number below 10^(19 * 2^(level + 1)), overwritten
+ * @param n the number of limbs of num
+ * @param powers decimal_powers of at least level + 1 entries
+ * @param level the index of the power that splits num
+ * @param out room for 19 * 2^(level + 1) characters
+ */
+void bigint::format_recursive(bigint_limb *num, size_t n, const std::vector<bigint> &powers, size_t level, char *out)
+{
+    while (n > 0 && num[n - 1] == 0)
+    {
+        n--;
+    }
+    if (level == 0 || 2 * powers[level].limbs.size() < bigint_threshold(&bigint_thresholds::recursive_conversion))
+    {
+        format_chunks(num, n, size_t(2) << level, out);
+        return;
+    }
+    const limb_vector &power = powers[level].limbs;
+    size_t half = decimal_chunk_digits << level;
+    if (n < power.size())
+    {
+        std::fill(out, out + half, '0');
+        format_recursive(num, n, powers, level - 1, out + half);
+        return;
+    }
+    bigint_scratch_frame frame;
+    bigint_limb *high = frame.take(n - power.size() + 1);
+    div_limbs(high, num, n, power.data(), power.size());
+    format_recursive(high, n - power.size() + 1, powers, level - 1, out);
+    format_recursive(num, power.size(), powers, level - 1, out + half);
 }
 
 /**
@@ -620,7 +2984,8 @@ std::ostream &operator<<(std::ostream &os, const bigint &num)
  */
 bigint bigint::operator++()
 {
-    *this = *this + 1; // Add 1 to the current object
+    BIGINT_COUNT_OP(bigint_op::increment);
+    add_small(1, false); // in place, stops as soon as the carry dies out
     return *this;
 }
 
@@ -644,7 +3009,8 @@ bigint bigint::operator++(int)
  */
 bigint bigint::operator--()
 {
-    *this = *this - 1; // Subtract 1 from the current object
+    BIGINT_COUNT_OP(bigint_op::decrement);
+    add_small(1, true); // in place, stops as soon as the borrow dies out
     return *this;
 }
 
@@ -660,3 +3026,109 @@ bigint bigint::operator--(int)
     --(*this);           // Use pre-decrement to modify the object
     return temp;
 }
+
+/**
+ * @brief compile-time limbs of a _big literal
+ *
+ * The characters of the literal are validated and converted to base 2^64 when the template
+ * is instantiated, and the limbs are stored as constant data. Digit separators (') are
+ * skipped.
+ *
+ * @tparam Chars the characters of the literal
+ */
+template <char... Chars>
+struct bigint_literal
+{
+    static constexpr char chars[] = {Chars...};
+
+    /**
+     * @brief check that the literal is a decimal integer
+     *
+     * @return true if every character is a digit or a digit separator
+     */
+    static constexpr bool is_valid()
+    {
+        for (char c : chars)
+        {
+            if ((c < '0' || c > '9') && c != '\'')
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+    static_assert(is_valid(), "_big literals must be decimal integers");
+
+    static constexpr size_t max_limbs = sizeof...(Chars) / 19 + 1; // every 19 digits fit in a limb
+
+    /**
+     * @brief convert the characters to base 2^64, one digit at a time
+     *
+     * @return std::array<bigint_limb, max_limbs> the little endian limbs with leading zeros
+     */
+    static constexpr std::array<bigint_limb, max_limbs> convert()
+    {
+        std::array<bigint_limb, max_limbs> result{};
+        for (char c : chars)
+        {
+            if (c == '\'')
+            {
+                continue;
+            }
+            bigint_limb carry = bigint_limb(c - '0');
+            for (bigint_limb &limb : result)
+            {
+                bigint_double_limb t = bigint_double_limb(limb) * 10 + carry;
+                limb = bigint_limb(t);
+                carry = bigint_limb(t >> bigint_limb_bits);
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief count the limbs without leading zeros
+     *
+     * @return size_t the number of significant limbs, 0 for the literal 0
+     */
+    static constexpr size_t count()
+    {
+        std::array<bigint_limb, max_limbs> all = convert();
+        size_t size = max_limbs;
+        while (size > 0 && all[size - 1] == 0)
+        {
+            size--;
+        }
+        return size;
+    }
+
+    /**
+     * @brief the significant limbs
+     *
+     * @return std::array<bigint_limb, count()> the limbs
+     */
+    static constexpr std::array<bigint_limb, count()> parse()
+    {
+        std::array<bigint_limb, max_limbs> all = convert();
+        std::array<bigint_limb, count()> result{};
+        std::copy(all.begin(), all.begin() + count(), result.begin());
+        return result;
+    }
+
+    static constexpr std::array<bigint_limb, count()> limbs = parse(); // little endian
+};
+
+/**
+ * @brief a user-defined literal for bigint constants, e.g. 123456789012345678901234567890_big
+ *
+ * The literal is parsed and validated at compile time, so at run time the bigint is
+ * only a copy of constant limbs. Negative constants are written with unary -.
+ *
+ * @tparam Chars the characters of the literal
+ * @return bigint the value of the literal
+ */
+template <char... Chars>
+bigint operator""_big()
+{
+    return bigint(bigint_view(bigint_literal<Chars...>::limbs));
+}
@@ -0,0 +1,188 @@
+/**
+ * @file bigint_batch.hpp
+ * @author Shihong Cong
+ * @brief Product trees, remainder trees and batch GCD over many numbers at once
+ * @version 0.1
+ * @date 2024-12-29
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#pragma once
+
+#include <span>
+#include <stdexcept>
+#include <vector>
+#include "bigint.hpp"
+
+/**
+ * @brief A binary tree of products over a list of numbers
+ *
+ * Level 0 holds the numbers themselves and each level above holds the products of adjacent
+ * pairs of the level below, an odd one out moving up unchanged, so the top level holds the
+ * product of all of them. Every multiplication is between two numbers of similar size, which
+ * is where Karatsuba multiplication pays off, so the whole tree costs about log2(N) times one
+ * multiplication of half the total size, instead of N multiplications by an ever growing product.
+ */
+class bigint_product_tree
+{
+public:
+    // Constructors
+    explicit bigint_product_tree(std::span<const bigint>); // build the tree over the leaves
+
+    // access
+    const bigint &product() const;                           // the product of all leaves, 1 if there are none
+    const std::vector<std::vector<bigint>> &levels() const; // levels()[0] are the leaves, levels().back() the product
+    size_t size() const;                                     // number of leaves
+
+    // reduction
+    std::vector<bigint> remainders(bigint_view) const; // x % leaf for every leaf, sharing work down the tree
+
+private:
+    std::vector<std::vector<bigint>> tree; // one vector per level, leaves first
+    size_t leaf_count;                     // an empty tree still holds the leaf 1
+};
+
+std::vector<bigint> batch_gcd(std::span<const bigint>); // gcd of each number with the product of all the others
+
+/**
+ * @brief Construct a new bigint_product_tree object
+ *
+ * @param leaves the numbers to multiply
+ */
+inline bigint_product_tree::bigint_product_tree(std::span<const bigint> leaves) : leaf_count(leaves.size())
+{
+    tree.emplace_back(leaves.begin(), leaves.end());
+    if (leaves.empty())
+    {
+        tree.back().emplace_back(1);
+    }
+    while (tree.back().size() > 1)
+    {
+        const std::vector<bigint> &below = tree.back();
+        std::vector<bigint> level;
+        level.reserve((below.size() + 1) / 2);
+        for (size_t i = 0; i + 1 < below.size(); i += 2)
+        {
+            level.push_back(below[i] * below[i + 1]);
+        }
+        if (below.size() % 2 != 0)
+        {
+            level.push_back(below.back());
+        }
+        tree.push_back(std::move(level));
+    }
+}
+
+/**
+ * @brief the product of all leaves
+ *
+ * @return const bigint& the root of the tree
+ */
+inline const bigint &bigint_product_tree::product() const
+{
+    return tree.back()[0];
+}
+
+/**
+ * @brief the levels of the tree
+ *
+ * @return const std::vector<std::vector<bigint>>& the leaves first, then each level of products
+ */
+inline const std::vector<std::vector<bigint>> &bigint_product_tree::levels() const
+{
+    return tree;
+}
+
+/**
+ * @brief the number of leaves
+ *
+ * @return size_t the number of numbers the tree was built over
+ */
+inline size_t bigint_product_tree::size() const
+{
+    return leaf_count;
+}
+
+/**
+ * @brief reduce one number modulo every leaf with a remainder tree
+ *
+ * The number is reduced modulo the root, then each remainder modulo the two children of its
+ * node, down to the leaves. Every division has a dividend about twice the size of its divisor,
+ * so reducing by N moduli costs about as much as the product tree itself, instead of N
+ * divisions of the full number.
+ *
+ * @param x the number to reduce
+ * @return std::vector<bigint> x % leaf for every leaf in order, with the sign of x, empty for an empty tree
+ */
+inline std::vector<bigint> bigint_product_tree::remainders(bigint_view x) const
+{
+    if (leaf_count == 0)
+    {
+        return {}; // only the placeholder leaf 1 is stored
+    }
+    std::vector<bigint> current{x % product()};
+    for (size_t level = tree.size() - 1; level > 0; level--)
+    {
+        const std::vector<bigint> &children = tree[level - 1];
+        std::vector<bigint> next;
+        next.reserve(children.size());
+        for (size_t i = 0; i < children.size(); i++)
+        {
+            next.push_back(current[i / 2] % children[i]);
+        }
+        current = std::move(next);
+    }
+    return current;
+}
+
+/**
+ * @brief find the factors each number shares with the others, with Bernstein's batch GCD
+ *
+ * With P the product of all the numbers, gcd(n_i, P / n_i) is the part of n_i shared with
+ * some other number. P / n_i is never formed: a remainder tree reduces P modulo n_i^2 for every
+ * i at once, going down the tree modulo the square of each node, and (P mod n_i^2) / n_i is
+ * congruent to P / n_i modulo n_i. The cost is a few multiplications of the size of P, in
+ * place of N^2 / 2 pairwise gcds. An RSA modulus sharing a prime with another one gets a
+ * result other than 1.
+ *
+ * @param numbers positive numbers, such as RSA moduli
+ * @return std::vector<bigint> gcd(n_i, product of the other numbers) for each number, in order
+ */
+inline std::vector<bigint> batch_gcd(std::span<const bigint> numbers)
+{
+    for (const bigint &n : numbers)
+    {
+        if (bigint_view(n) <= bigint(0))
+        {
+            throw std::invalid_argument("batch_gcd needs positive numbers");
+        }
+    }
+    if (numbers.empty())
+    {
+        return {};
+    }
+
+    bigint_product_tree products(numbers);
+    const std::vector<std::vector<bigint>> &tree = products.levels();
+    std::vector<bigint> current{products.product()};
+    for (size_t level = tree.size() - 1; level > 0; level--)
+    {
+        const std::vector<bigint> &children = tree[level - 1];
+        std::vector<bigint> next;
+        next.reserve(children.size());
+        for (size_t i = 0; i < children.size(); i++)
+        {
+            next.push_back(current[i / 2] % (children[i] * children[i]));
+        }
+        current = std::move(next);
+    }
+
+    std::vector<bigint> result;
+    result.reserve(numbers.size());
+    for (size_t i = 0; i < numbers.size(); i++)
+    {
+        result.push_back(gcd(current[i] / numbers[i], numbers[i]));
+    }
+    return result;
+}
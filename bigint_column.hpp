@@ -0,0 +1,518 @@
+/**
+ * @file bigint_column.hpp
+ * @author Shihong Cong
+ * @brief A column of many bigints packed into one limb buffer
+ * @version 0.1
+ * @date 2024-12-29
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "bigint.hpp"
+
+/**
+ * @brief A sequence of bigints stored as one contiguous buffer of limbs
+ *
+ * The limbs of every value are stored trimmed, one value after another, in a single buffer.
+ * An offset index gives where each value starts, and a bitmap holds the signs. A million values
+ * are then three allocations rather than a million, and a scan reads memory in order. Values are
+ * read back as bigint_view, so every operator on views applies to them without copying.
+ */
+class bigint_column
+{
+public:
+    // Constructors
+    bigint_column() = default;
+    static bigint_column parse(std::string_view, char = '\n'); // decimal values separated by a delimiter, throws on a bad value
+
+    // access
+    size_t size() const;                  // number of values
+    bool empty() const;                   // true if there are no values
+    size_t limb_count() const;            // limbs stored for all values
+    bigint_view operator[](size_t) const; // a view of a value, valid until the column changes
+    bigint_view at(size_t) const;         // operator[] with bounds checking
+
+    // modifiers
+    void push_back(bigint_view);  // append a copy of a value
+    void reserve(size_t, size_t); // room for a number of values and a number of limbs
+    void clear();                 // remove every value, keeping the buffers
+    void sort();                  // ascending order
+
+    // bulk output
+    std::string format(char = '\n') const; // decimal values separated by a delimiter
+
+    bool operator==(const bigint_column &) const = default;
+
+    // element-wise arithmetic, throwing std::invalid_argument if the lengths differ
+    friend bigint_column operator+(const bigint_column &, const bigint_column &);
+    friend bigint_column operator-(const bigint_column &, const bigint_column &);
+    friend bigint_column operator*(const bigint_column &, const bigint_column &);
+    friend bigint_column operator+(const bigint_column &, bigint_view);
+    friend bigint_column operator-(const bigint_column &, bigint_view);
+    friend bigint_column operator*(const bigint_column &, bigint_view);
+
+private:
+    using limb_vector = std::vector<bigint_limb, bigint_allocator<bigint_limb>>;
+
+    limb_vector limbs;              // the limbs of every value, trimmed, one value after another
+    std::vector<size_t> offsets{0}; // value i occupies limbs[offsets[i], offsets[i + 1])
+    std::vector<uint64_t> signs;    // bit i % 64 of word i / 64 is set if value i is negative
+
+    bigint_limb *append(size_t);                   // room for a new value of at most n limbs
+    void finish(size_t, bool);                     // end the new value at n limbs, trimmed, with a sign
+    void push_parsed(std::string_view);            // append a decimal value, throws on a bad one
+    void push_sum(bigint_view, bigint_view, bool); // append a + b, or a - b
+    void push_product(bigint_view, bigint_view);   // append a * b
+    template <typename Right, typename Op>
+    static bigint_column elementwise(const bigint_column &, size_t, Right, Op); // apply op to each value and a right operand
+};
+
+/**
+ * @brief the number of values
+ *
+ * @return size_t the number of values
+ */
+inline size_t bigint_column::size() const
+{
+    return offsets.size() - 1;
+}
+
+/**
+ * @brief check whether the column holds no values
+ *
+ * @return true if there are no values
+ */
+inline bool bigint_column::empty() const
+{
+    return size() == 0;
+}
+
+/**
+ * @brief the limbs stored for all values together
+ *
+ * @return size_t the number of limbs, zeros taking none
+ */
+inline size_t bigint_column::limb_count() const
+{
+    return limbs.size();
+}
+
+/**
+ * @brief a view of a value
+ *
+ * @param i the index of the value, below size()
+ * @return bigint_view a view into the column's buffer, invalidated by any change to the column
+ */
+inline bigint_view bigint_column::operator[](size_t i) const
+{
+    std::span<const bigint_limb> value(limbs.data() + offsets[i], offsets[i + 1] - offsets[i]);
+    return bigint_view(value, (signs[i / 64] >> (i % 64)) & 1);
+}
+
+/**
+ * @brief a view of a value, with bounds checking
+ *
+ * @param i the index of the value
+ * @return bigint_view a view into the column's buffer, throws std::out_of_range if i >= size()
+ */
+inline bigint_view bigint_column::at(size_t i) const
+{
+    if (i >= size())
+    {
+        throw std::out_of_range("bigint_column index " + std::to_string(i) + " out of range");
+    }
+    return (*this)[i];
+}
+
+/**
+ * @brief a helper function to make room for a new value at the end of the buffer
+ *
+ * @param n the most limbs the value can take
+ * @return bigint_limb* n zeroed limbs, valid until finish is called
+ */
+inline bigint_limb *bigint_column::append(size_t n)
+{
+    size_t start = limbs.size();
+    limbs.resize(start + n);
+    return limbs.data() + start;
+}
+
+/**
+ * @brief a helper function to end the value written after append
+ *
+ * @param n the limbs written, at most those appended, leading zeros included
+ * @param negative true if the value is negative, ignored for zero
+ */
+inline void bigint_column::finish(size_t n, bool negative)
+{
+    size_t start = offsets.back();
+    while (n > 0 && limbs[start + n - 1] == 0)
+    {
+        n--;
+    }
+    limbs.resize(start + n);
+    size_t i = size();
+    if (i % 64 == 0)
+    {
+        signs.push_back(0);
+    }
+    if (negative && n > 0)
+    {
+        signs[i / 64] |= uint64_t(1) << (i % 64);
+    }
+    offsets.push_back(start + n);
+}
+
+/**
+ * @brief append a copy of a value
+ *
+ * @param num a view, which may refer to a value in this column
+ */
+inline void bigint_column::push_back(bigint_view num)
+{
+    num = num.trimmed();
+    // the function objects order any two pointers, the built-in operators only those into one array
+    const bigint_limb *data = num.limbs().data();
+    if (std::greater_equal<const bigint_limb *>{}(data, limbs.data()) &&
+        std::less<const bigint_limb *>{}(data, limbs.data() + limbs.size()))
+    {
+        push_back(bigint(num)); // the buffer may move as it grows
+        return;
+    }
+    bigint_limb *out = append(num.size());
+    std::copy(num.limbs().begin(), num.limbs().end(), out);
+    finish(num.size(), num.negative());
+}
+
+/**
+ * @brief reserve room so that appending does not reallocate
+ *
+ * @param values the number of values
+ * @param limb_total the number of limbs of all values together
+ */
+inline void bigint_column::reserve(size_t values, size_t limb_total)
+{
+    offsets.reserve(values + 1);
+    signs.reserve((values + 63) / 64);
+    limbs.reserve(limb_total);
+}
+
+/**
+ * @brief remove every value, keeping the buffers for reuse
+ *
+ */
+inline void bigint_column::clear()
+{
+    limbs.clear();
+    offsets.resize(1);
+    signs.clear();
+}
+
+/**
+ * @brief a helper function to append a decimal value
+ *
+ * The digits are validated and converted straight into the column's buffer, so no bigint is made.
+ *
+ * @param field an optional '-' followed by decimal digits
+ */
+inline void bigint_column::push_parsed(std::string_view field)
+{
+    bool negative = !field.empty() && field[0] == '-';
+    size_t first = negative ? 1 : 0;
+    if (first == field.size() || !bigint_active_kernels.all_digits(field.data() + first, field.size() - first))
+    {
+        throw std::invalid_argument("Invalid argument: " + std::string(field));
+    }
+    size_t digits = field.size() - first;
+    bigint_limb *out = append(digits / bigint::decimal_chunk_digits + 1);
+    finish(bigint::parse_decimal(field.data() + first, digits, out), negative);
+}
+
+/**
+ * @brief parse values separated by a delimiter
+ *
+ * A delimiter at the end of the text is allowed, and with the default '\n' a '\r' before it is
+ * skipped, so lines ending in "\r\n" parse too.
+ *
+ * @param text decimal values, each an optional '-' followed by digits
+ * @param delimiter the character between values
+ * @return bigint_column the values in order, throws std::invalid_argument on an empty or bad value
+ */
+inline bigint_column bigint_column::parse(std::string_view text, char delimiter)
+{
+    BIGINT_COUNT_OP(bigint_op::parse);
+    bigint_column column;
+    column.limbs.reserve(text.size() / bigint::decimal_chunk_digits + 1);
+    size_t pos = 0;
+    while (pos < text.size())
+    {
+        size_t end = std::min(text.find(delimiter, pos), text.size());
+        std::string_view field = text.substr(pos, end - pos);
+        if (delimiter == '\n' && !field.empty() && field.back() == '\r')
+        {
+            field.remove_suffix(1);
+        }
+        column.push_parsed(field);
+        pos = end + 1;
+    }
+    return column;
+}
+
+/**
+ * @brief write every value in decimal
+ *
+ * @param delimiter the character between values
+ * @return std::string the values in order, with no delimiter after the last
+ */
+inline std::string bigint_column::format(char delimiter) const
+{
+    BIGINT_COUNT_OP(bigint_op::print);
+    std::string text;
+    text.reserve(limbs.size() * 20 + size() * 2); // 2^64 has 20 digits
+    for (size_t i = 0; i < size(); i++)
+    {
+        if (i > 0)
+        {
+            text.push_back(delimiter);
+        }
+        bigint::append_decimal((*this)[i], text);
+    }
+    return text;
+}
+
+/**
+ * @brief sort the values in ascending order
+ *
+ * Each value gets a 128-bit key of its sign, length and top limb, which orders values of one
+ * limb exactly and most others too, and the keys are sorted with the indices alongside, so
+ * most comparisons read two keys next to each other instead of two values anywhere in the
+ * buffer. Equal keys fall back to comparing the values. The buffer is then rebuilt once in
+ * the new order.
+ */
+inline void bigint_column::sort()
+{
+    __extension__ typedef __int128 key_type;
+    std::vector<std::pair<key_type, size_t>> keys(size());
+    for (size_t i = 0; i < size(); i++)
+    {
+        bigint_view value = (*this)[i];
+        key_type key = value.is_zero() ? 0 : key_type((bigint_double_limb(value.size()) << bigint_limb_bits) | value[value.size() - 1]);
+        keys[i] = {value.negative() ? -key : key, i};
+    }
+    std::sort(keys.begin(), keys.end(),
+              [this](const std::pair<key_type, size_t> &a, const std::pair<key_type, size_t> &b)
+              {
+                  if (a.first != b.first)
+                  {
+                      return a.first < b.first;
+                  }
+                  return (*this)[a.second] < (*this)[b.second];
+              });
+    bigint_column sorted;
+    sorted.reserve(size(), limbs.size());
+    for (const std::pair<key_type, size_t> &key : keys)
+    {
+        sorted.push_back((*this)[key.second]);
+    }
+    *this = std::move(sorted);
+}
+
+/**
+ * @brief a helper function to append the sum or difference of two values
+ *
+ * Magnitudes of the same sign are added, and otherwise the smaller is subtracted from the
+ * larger, straight into the column's buffer with bigint_mpn_add and bigint_mpn_sub.
+ *
+ * @param num1 a view
+ * @param num2 a view
+ * @param subtract true for num1 - num2, false for num1 + num2
+ */
+inline void bigint_column::push_sum(bigint_view num1, bigint_view num2, bool subtract)
+{
+    num1 = num1.trimmed();
+    num2 = num2.trimmed();
+    bool negative2 = num2.negative() != subtract;
+    if (num1.is_zero() || num2.is_zero() || num1.negative() == negative2)
+    {
+        bool negative = num1.is_zero() ? negative2 : num1.negative();
+        bigint_view big = num1.size() >= num2.size() ? num1 : num2;
+        bigint_view small = num1.size() >= num2.size() ? num2 : num1;
+        bigint_limb *out = append(big.size() + 1);
+        out[big.size()] = bigint_mpn_add(out, big.limbs().data(), big.size(), small.limbs().data(), small.size());
+        finish(big.size() + 1, negative);
+        return;
+    }
+    bool first_larger = bigint::compare_magnitude(num1, num2) >= 0;
+    bigint_view big = first_larger ? num1 : num2;
+    bigint_view small = first_larger ? num2 : num1;
+    bigint_limb *out = append(big.size());
+    bigint_mpn_sub(out, big.limbs().data(), big.size(), small.limbs().data(), small.size());
+    finish(big.size(), first_larger ? num1.negative() : negative2);
+}
+
+/**
+ * @brief a helper function to append the product of two values
+ *
+ * The product is written straight into the column's buffer, by the fixed-size kernels for
+ * short values and by Karatsuba multiplication above the threshold.
+ *
+ * @param num1 a view
+ * @param num2 a view
+ */
+inline void bigint_column::push_product(bigint_view num1, bigint_view num2)
+{
+    num1 = num1.trimmed();
+    num2 = num2.trimmed();
+    size_t n = num1.size();
+    size_t m = num2.size();
+    bigint_limb *out = append(n == 0 || m == 0 ? 0 : n + m);
+    if (n == 0 || m == 0)
+    {
+        finish(0, false);
+    }
+    else
+    {
+        if (n <= bigint_small_limbs && m <= bigint_small_limbs)
+        {
+            bigint_mul_small[n - 1][m - 1](out, num1.limbs().data(), num2.limbs().data());
+        }
+        else
+        {
+            bigint::mul_limbs(out, num1.limbs().data(), n, num2.limbs().data(), m);
+        }
+        finish(n + m, num1.negative() != num2.negative());
+    }
+}
+
+/**
+ * @brief a helper function to build a column value by value
+ *
+ * @tparam Right a callable giving the right operand for an index
+ * @tparam Op a callable appending the result for a left and a right operand to a column
+ * @param left the left operands
+ * @param limb_estimate the limbs to reserve for the result
+ * @param right the right operands
+ * @param op the operation
+ * @return bigint_column the results in order
+ */
+template <typename Right, typename Op>
+bigint_column bigint_column::elementwise(const bigint_column &left, size_t limb_estimate, Right right, Op op)
+{
+    bigint_column result;
+    result.reserve(left.size(), limb_estimate);
+    for (size_t i = 0; i < left.size(); i++)
+    {
+        op(result, left[i], right(i));
+    }
+    return result;
+}
+
+/**
+ * @brief a helper function to check that two columns can be combined element by element
+ *
+ * @param left a column
+ * @param right a column
+ */
+inline void bigint_column_check_lengths(const bigint_column &left, const bigint_column &right)
+{
+    if (left.size() != right.size())
+    {
+        throw std::invalid_argument("bigint_column lengths differ: " + std::to_string(left.size()) + " and " +
+                                    std::to_string(right.size()));
+    }
+}
+
+/**
+ * @brief Overload the + operator to add two columns element by element
+ *
+ * @param left a column
+ * @param right a column of the same length
+ * @return bigint_column left[i] + right[i] for every i
+ */
+inline bigint_column operator+(const bigint_column &left, const bigint_column &right)
+{
+    bigint_column_check_lengths(left, right);
+    return bigint_column::elementwise(left, left.limb_count() + right.limb_count() + left.size(),
+                                      [&](size_t i) { return right[i]; },
+                                      [](bigint_column &out, bigint_view a, bigint_view b) { out.push_sum(a, b, false); });
+}
+
+/**
+ * @brief Overload the - operator to subtract two columns element by element
+ *
+ * @param left a column
+ * @param right a column of the same length
+ * @return bigint_column left[i] - right[i] for every i
+ */
+inline bigint_column operator-(const bigint_column &left, const bigint_column &right)
+{
+    bigint_column_check_lengths(left, right);
+    return bigint_column::elementwise(left, left.limb_count() + right.limb_count() + left.size(),
+                                      [&](size_t i) { return right[i]; },
+                                      [](bigint_column &out, bigint_view a, bigint_view b) { out.push_sum(a, b, true); });
+}
+
+/**
+ * @brief Overload the * operator to multiply two columns element by element
+ *
+ * @param left a column
+ * @param right a column of the same length
+ * @return bigint_column left[i] * right[i] for every i
+ */
+inline bigint_column operator*(const bigint_column &left, const bigint_column &right)
+{
+    bigint_column_check_lengths(left, right);
+    return bigint_column::elementwise(left, left.limb_count() + right.limb_count(), [&](size_t i) { return right[i]; },
+                                      [](bigint_column &out, bigint_view a, bigint_view b) { out.push_product(a, b); });
+}
+
+/**
+ * @brief Overload the + operator to add one number to every value of a column
+ *
+ * @param left a column
+ * @param right a view
+ * @return bigint_column left[i] + right for every i
+ */
+inline bigint_column operator+(const bigint_column &left, bigint_view right)
+{
+    return bigint_column::elementwise(left, left.limb_count() + left.size() * (right.size() + 1),
+                                      [=](size_t) { return right; },
+                                      [](bigint_column &out, bigint_view a, bigint_view b) { out.push_sum(a, b, false); });
+}
+
+/**
+ * @brief Overload the - operator to subtract one number from every value of a column
+ *
+ * @param left a column
+ * @param right a view
+ * @return bigint_column left[i] - right for every i
+ */
+inline bigint_column operator-(const bigint_column &left, bigint_view right)
+{
+    return bigint_column::elementwise(left, left.limb_count() + left.size() * (right.size() + 1),
+                                      [=](size_t) { return right; },
+                                      [](bigint_column &out, bigint_view a, bigint_view b) { out.push_sum(a, b, true); });
+}
+
+/**
+ * @brief Overload the * operator to multiply every value of a column by one number
+ *
+ * @param left a column
+ * @param right a view
+ * @return bigint_column left[i] * right for every i
+ */
+inline bigint_column operator*(const bigint_column &left, bigint_view right)
+{
+    return bigint_column::elementwise(left, left.limb_count() + left.size() * right.size(), [=](size_t) { return right; },
+                                      [](bigint_column &out, bigint_view a, bigint_view b) { out.push_product(a, b); });
+}
@@ -0,0 +1,286 @@
+/**
+ * @file bigint_digits.hpp
+ * @author Shihong Cong
+ * @brief Word-parallel kernels that validate, parse and format runs of decimal and hexadecimal digits
+ * @version 0.1
+ * @date 2024-12-29
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * Validation checks 32 characters per step with AVX2, 16 with SSE2 and 8 per 64-bit word
+ * (SWAR) otherwise. Parsing converts 16 digits per step with SSSE3 and 8 per word otherwise,
+ * and formatting expands 8 digits per word. The AVX2 check is chosen at run time through
+ * bigint_kernels.hpp, the SSSE3 parse at compile time from the target flags, such as -mssse3.
+ * Hexadecimal output also expands 8 digits per word. The word paths need only a little-endian
+ * machine, and big-endian machines fall back to one digit at a time.
+ */
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <immintrin.h>
+#endif
+
+constexpr bool bigint_swar_digits = std::endian::native == std::endian::little; // the word kernels assume the first character is the lowest byte
+
+/**
+ * @brief check that every character of a run is a decimal digit
+ *
+ * @param str the first character
+ * @param n the number of characters
+ * @return true if all n characters are '0' to '9'
+ */
+inline bool bigint_all_digits(const char *str, size_t n)
+{
+    size_t i = 0;
+#if defined(__SSE2__)
+    const __m128i zeros = _mm_set1_epi8('0');
+    const __m128i nines = _mm_set1_epi8(9);
+    for (; i + 16 <= n; i += 16)
+    {
+        // digits become 0 to 9, everything else wraps to 10 to 255
+        __m128i digits = _mm_sub_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(str + i)), zeros);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(digits, nines), digits)) != 0xFFFF)
+        {
+            return false;
+        }
+    }
+#endif
+    for (; i + 8 <= n; i += 8)
+    {
+        // a digit has high nibble 3, and still has it after adding 6
+        uint64_t word;
+        std::memcpy(&word, str + i, 8);
+        if ((word & 0xF0F0F0F0F0F0F0F0) != 0x3030303030303030 ||
+            ((word + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) != 0x3030303030303030)
+        {
+            return false;
+        }
+    }
+    for (; i < n; i++)
+    {
+        if (str[i] < '0' || str[i] > '9')
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+#if defined(__x86_64__) && defined(__GNUC__)
+/**
+ * @brief check that every character of a run is a decimal digit, 32 at a time with AVX2
+ *
+ * It is compiled for AVX2 whatever the target flags, and is only called through
+ * bigint_active_kernels on CPUs that have it.
+ *
+ * @param str the first character
+ * @param n the number of characters
+ * @return true if all n characters are '0' to '9'
+ */
+__attribute__((target("avx2"))) inline bool bigint_all_digits_avx2(const char *str, size_t n)
+{
+    const __m256i zeros = _mm256_set1_epi8('0');
+    const __m256i nines = _mm256_set1_epi8(9);
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32)
+    {
+        __m256i digits = _mm256_sub_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(str + i)), zeros);
+        if (_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_min_epu8(digits, nines), digits)) != -1)
+        {
+            return false;
+        }
+    }
+    return bigint_all_digits(str + i, n - i);
+}
+#endif
+
+/**
+ * @brief convert 8 decimal digits at once within one 64-bit word
+ *
+ * Adjacent digits are combined into pairs, pairs into groups of 4 and groups into the result,
+ * each step one multiplication that scales the earlier half and adds the later one.
+ *
+ * @param str 8 characters that have passed bigint_all_digits
+ * @return uint64_t their value, below 10^8
+ */
+inline uint64_t bigint_parse_8_digits(const char *str)
+{
+    uint64_t word;
+    std::memcpy(&word, str, 8);
+    word -= 0x3030303030303030;
+    word = ((word & 0x0F0F0F0F0F0F0F0F) * (10 * 0x100 + 1)) >> 8;
+    word = ((word & 0x00FF00FF00FF00FF) * (100 * 0x10000 + 1)) >> 16;
+    return ((word & 0x0000FFFF0000FFFF) * (10000 * 0x100000000 + 1)) >> 32;
+}
+
+#if defined(__SSSE3__)
+/**
+ * @brief convert 16 decimal digits at once in an SSE register
+ *
+ * @param str 16 characters that have passed bigint_all_digits
+ * @return uint64_t their value, below 10^16
+ */
+inline uint64_t bigint_parse_16_digits(const char *str)
+{
+    __m128i digits = _mm_sub_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(str)), _mm_set1_epi8('0'));
+    __m128i pairs = _mm_maddubs_epi16(digits, _mm_set_epi8(1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10));
+    __m128i quads = _mm_madd_epi16(pairs, _mm_set_epi16(1, 100, 1, 100, 1, 100, 1, 100));
+    quads = _mm_packs_epi32(quads, quads); // below 10^4, so the 16-bit saturation never triggers
+    __m128i octets = _mm_madd_epi16(quads, _mm_set_epi16(1, 10000, 1, 10000, 1, 10000, 1, 10000));
+    uint64_t both = uint64_t(_mm_cvtsi128_si64(octets));
+    return (both & 0xFFFFFFFF) * 100000000 + (both >> 32);
+}
+#endif
+
+/**
+ * @brief convert a run of at most 19 validated decimal digits to a limb
+ *
+ * @param str the first character, the most significant digit
+ * @param n the number of digits, from 0 to 19
+ * @return uint64_t their value
+ */
+inline uint64_t bigint_parse_digits(const char *str, size_t n)
+{
+    uint64_t value = 0;
+    if constexpr (bigint_swar_digits)
+    {
+        size_t head = n % 8;
+#if defined(__SSSE3__)
+        if (n >= 16)
+        {
+            head = n - 16;
+        }
+#endif
+        for (size_t i = 0; i < head; i++)
+        {
+            value = value * 10 + uint64_t(str[i] - '0');
+        }
+#if defined(__SSSE3__)
+        if (n >= 16)
+        {
+            return value * 10000000000000000 + bigint_parse_16_digits(str + head);
+        }
+#endif
+        for (size_t i = head; i < n; i += 8)
+        {
+            value = value * 100000000 + bigint_parse_8_digits(str + i);
+        }
+    }
+    else
+    {
+        for (size_t i = 0; i < n; i++)
+        {
+            value = value * 10 + uint64_t(str[i] - '0');
+        }
+    }
+    return value;
+}
+
+/**
+ * @brief write a number below 10^8 as exactly 8 zero-padded digits
+ *
+ * The number is split into two groups of 4 digits in the two halves of a word, then each
+ * group into 2 pairs, then each pair into 2 digits, dividing by multiplying with a scaled reciprocal.
+ *
+ * @param value a number below 10^8
+ * @param out room for 8 characters
+ */
+inline void bigint_format_8_digits(uint64_t value, char *out)
+{
+    if constexpr (bigint_swar_digits)
+    {
+        uint64_t quads = value / 10000 | (value % 10000) << 32;
+        uint64_t high = ((quads * 10486) >> 20) & 0x0000007F0000007F; // each group / 100
+        uint64_t pairs = high | (quads - high * 100) << 16;
+        high = ((pairs * 103) >> 10) & 0x000F000F000F000F; // each pair / 10
+        uint64_t digits = (high | (pairs - high * 10) << 8) + 0x3030303030303030;
+        std::memcpy(out, &digits, 8);
+    }
+    else
+    {
+        for (size_t i = 8; i > 0; i--)
+        {
+            out[i - 1] = char('0' + value % 10);
+            value /= 10;
+        }
+    }
+}
+
+/**
+ * @brief write a limb as exactly 19 zero-padded digits
+ *
+ * @param value a number below 10^19
+ * @param out room for 19 characters
+ */
+inline void bigint_format_19_digits(uint64_t value, char *out)
+{
+    uint64_t top = value / 10000000000000000;
+    value %= 10000000000000000;
+    out[0] = char('0' + top / 100);
+    out[1] = char('0' + top / 10 % 10);
+    out[2] = char('0' + top % 10);
+    bigint_format_8_digits(value / 100000000, out + 3);
+    bigint_format_8_digits(value % 100000000, out + 11);
+}
+
+constexpr char bigint_radix_chars[] = "0123456789abcdefghijklmnopqrstuvwxyz"; // digit characters of radices up to 36
+
+/**
+ * @brief the value of every character as a digit, either case, 255 for characters that are not digits
+ *
+ */
+constexpr std::array<unsigned char, 256> bigint_radix_values = []
+{
+    std::array<unsigned char, 256> table;
+    table.fill(255);
+    for (unsigned char i = 0; i < 36; i++)
+    {
+        table[static_cast<unsigned char>(bigint_radix_chars[i])] = i;
+        if (i >= 10)
+        {
+            table[static_cast<unsigned char>(bigint_radix_chars[i] - 'a' + 'A')] = i;
+        }
+    }
+    return table;
+}();
+
+/**
+ * @brief write a limb as exactly 16 zero-padded lowercase hexadecimal digits
+ *
+ * Each 32-bit half is spread out to one nibble per byte, and the bytes of 10 or more are
+ * moved up to the letters, 8 digits per word.
+ *
+ * @param value a limb
+ * @param out room for 16 characters
+ */
+inline void bigint_format_16_hex(uint64_t value, char *out)
+{
+    if constexpr (bigint_swar_digits)
+    {
+        for (int half = 0; half < 2; half++)
+        {
+            uint64_t nibbles = half == 0 ? value >> 32 : value & 0xFFFFFFFF;
+            nibbles = (nibbles | nibbles << 16) & 0x0000FFFF0000FFFF;
+            nibbles = (nibbles | nibbles << 8) & 0x00FF00FF00FF00FF;
+            nibbles = (nibbles | nibbles << 4) & 0x0F0F0F0F0F0F0F0F;
+            nibbles = __builtin_bswap64(nibbles); // the most significant digit first in memory
+            uint64_t letters = ((nibbles + 0x0606060606060606) >> 4) & 0x0101010101010101;
+            uint64_t chars = nibbles + 0x3030303030303030 + letters * ('a' - '0' - 10);
+            std::memcpy(out + 8 * half, &chars, 8);
+        }
+    }
+    else
+    {
+        for (size_t i = 16; i > 0; i--)
+        {
+            out[i - 1] = bigint_radix_chars[value & 0xF];
+            value >>= 4;
+        }
+    }
+}
@@ -0,0 +1,616 @@
+/**
+ * @file bigint_kernels.hpp
+ * @author Shihong Cong
+ * @brief Limb-array kernels for addition and multiplication, selected for the running CPU
+ * @version 0.1
+ * @date 2024-12-29
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * Every kernel has a portable version. On x86-64 with GCC or Clang, faster versions are
+ * compiled alongside it with per-function target attributes, so one binary built without
+ * -march flags still uses BMI2, ADX and AVX2 instructions on the machines that have them.
+ * The CPU is inspected once, before main, and bigint_active_kernels holds the chosen table.
+ *
+ * Operands of up to bigint_small_limbs limbs instead go through kernels instantiated for
+ * their exact lengths, fully unrolled, and looked up in tables indexed by the lengths.
+ */
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include "bigint_digits.hpp"
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#define BIGINT_X86_KERNELS 1
+#endif
+
+using bigint_limb = uint64_t;                                // one base 2^64 digit
+__extension__ typedef unsigned __int128 bigint_double_limb; // holds the product of two limbs
+constexpr int bigint_limb_bits = 64;                         // bits per limb
+
+/**
+ * @brief the instruction set extensions the kernels can use
+ *
+ */
+struct bigint_cpu_features
+{
+    bool bmi2 = false;    // mulx, a multiply that leaves the flags alone
+    bool adx = false;     // adcx and adox, two independent carry chains
+    bool avx2 = false;    // 256-bit integer vectors
+    bool avx512f = false; // 512-bit vectors, detected but not used by any kernel yet
+
+    static bigint_cpu_features detect(); // the features of the running CPU
+};
+
+/**
+ * @brief a table of kernels, one function pointer per operation
+ *
+ * Limb arrays are little endian. Outputs may equal an input of the same length in add_n and
+ * sub_n, but must not otherwise overlap an input.
+ */
+struct bigint_kernels
+{
+    bigint_limb (*add_n)(bigint_limb *, const bigint_limb *, const bigint_limb *, size_t);    // out = a + b over n limbs, returns carry
+    bigint_limb (*sub_n)(bigint_limb *, const bigint_limb *, const bigint_limb *, size_t);    // out = a - b over n limbs, returns borrow
+    bigint_limb (*addmul_1)(bigint_limb *, const bigint_limb *, size_t, bigint_limb);         // out += a * m over n limbs, returns carry
+    bigint_limb (*submul_1)(bigint_limb *, const bigint_limb *, size_t, bigint_limb);         // out -= a * m over n limbs, returns borrow
+    void (*mul_basecase)(bigint_limb *, const bigint_limb *, size_t, const bigint_limb *, size_t); // out = a * b, n + m limbs
+    bool (*all_digits)(const char *, size_t);                                                 // true if every character is a decimal digit
+    const char *name;                                                                          // the widest extension used
+
+    static bigint_kernels select(const bigint_cpu_features &); // the fastest kernels the features allow
+};
+
+/**
+ * @brief add two limb arrays of equal length
+ *
+ * @param out n limbs for the sum, may be a or b
+ * @param a n limbs
+ * @param b n limbs
+ * @param n the number of limbs
+ * @return bigint_limb the carry out of the top limb
+ */
+inline bigint_limb bigint_add_n_generic(bigint_limb *out, const bigint_limb *a, const bigint_limb *b, size_t n)
+{
+    bigint_limb carry = 0;
+    for (size_t i = 0; i < n; i++)
+    {
+        bigint_double_limb sum = bigint_double_limb(a[i]) + b[i] + carry;
+        out[i] = bigint_limb(sum);
+        carry = bigint_limb(sum >> bigint_limb_bits);
+    }
+    return carry;
+}
+
+/**
+ * @brief subtract two limb arrays of equal length
+ *
+ * @param out n limbs for the difference, may be a or b
+ * @param a n limbs
+ * @param b n limbs to be subtracted
+ * @param n the number of limbs
+ * @return bigint_limb the borrow out of the top limb
+ */
+inline bigint_limb bigint_sub_n_generic(bigint_limb *out, const bigint_limb *a, const bigint_limb *b, size_t n)
+{
+    bigint_limb borrow = 0;
+    for (size_t i = 0; i < n; i++)
+    {
+        bigint_limb x = a[i];
+        bigint_limb y = b[i];
+        out[i] = x - y - borrow;
+        borrow = (x < y) || (x - y < borrow); // borrow from the next limb
+    }
+    return borrow;
+}
+
+/**
+ * @brief add a multiple of a limb array into another, in place
+ *
+ * @param out n limbs to be added to
+ * @param a n limbs
+ * @param n the number of limbs
+ * @param m a limb multiplier
+ * @return bigint_limb the carry out of the top limb
+ */
+inline bigint_limb bigint_addmul_1_generic(bigint_limb *out, const bigint_limb *a, size_t n, bigint_limb m)
+{
+    bigint_limb carry = 0;
+    for (size_t i = 0; i < n; i++)
+    {
+        bigint_double_limb t = bigint_double_limb(a[i]) * m + out[i] + carry;
+        out[i] = bigint_limb(t);
+        carry = bigint_limb(t >> bigint_limb_bits);
+    }
+    return carry;
+}
+
+/**
+ * @brief subtract a multiple of a limb array from another, in place
+ *
+ * @param out n limbs to be subtracted from
+ * @param a n limbs
+ * @param n the number of limbs
+ * @param m a limb multiplier
+ * @return bigint_limb the borrow out of the top limb
+ */
+inline bigint_limb bigint_submul_1_generic(bigint_limb *out, const bigint_limb *a, size_t n, bigint_limb m)
+{
+    bigint_limb borrow = 0;
+    for (size_t i = 0; i < n; i++)
+    {
+        bigint_double_limb t = bigint_double_limb(a[i]) * m + borrow;
+        bigint_limb low = bigint_limb(t);
+        borrow = bigint_limb(t >> bigint_limb_bits) + (out[i] < low ? 1 : 0);
+        out[i] -= low;
+    }
+    return borrow;
+}
+
+/**
+ * @brief column-wise (Comba) long multiplication of two limb arrays
+ *
+ * Column k of the product is the sum of every a[i] * b[k - i]. The sum is accumulated
+ * in three limbs, the low limb is written out, and the other two carry into the next column,
+ * so the product is written once into the output and nothing else is allocated.
+ *
+ * @param out n + m limbs, overwritten with the product
+ * @param a n limbs, n > 0
+ * @param n the number of limbs of a
+ * @param b m limbs, m > 0
+ * @param m the number of limbs of b
+ */
+inline void bigint_mul_basecase_generic(bigint_limb *out, const bigint_limb *a, size_t n, const bigint_limb *b, size_t m)
+{
+    bigint_limb low = 0;    // bits 0-63 of the column sum
+    bigint_limb middle = 0; // bits 64-127
+    bigint_limb high = 0;   // bits 128-191
+    for (size_t k = 0; k + 1 < n + m; k++)
+    {
+        size_t first = k < m ? 0 : k - m + 1;
+        size_t last = std::min(k, n - 1);
+        for (size_t i = first; i <= last; i++)
+        {
+            bigint_double_limb product = bigint_double_limb(a[i]) * b[k - i];
+            bigint_double_limb sum = bigint_double_limb(low) + bigint_limb(product);
+            low = bigint_limb(sum);
+            sum = bigint_double_limb(middle) + bigint_limb(product >> bigint_limb_bits) + bigint_limb(sum >> bigint_limb_bits);
+            middle = bigint_limb(sum);
+            high += bigint_limb(sum >> bigint_limb_bits);
+        }
+        out[k] = low;
+        low = middle;
+        middle = high;
+        high = 0;
+    }
+    out[n + m - 1] = low;
+}
+
+#if defined(BIGINT_X86_KERNELS)
+/**
+ * @brief add two limb arrays with an unrolled adc loop
+ *
+ * The portable loop moves the carry through a register on every limb, because the compiler
+ * cannot keep it in the carry flag across iterations. This loop chains adc four limbs at a
+ * time, and needs only the base x86-64 instruction set.
+ *
+ * @param out n limbs for the sum, may be a or b
+ * @param a n limbs
+ * @param b n limbs
+ * @param n the number of limbs
+ * @return bigint_limb the carry out of the top limb
+ */
+inline bigint_limb bigint_add_n_x86(bigint_limb *out, const bigint_limb *a, const bigint_limb *b, size_t n)
+{
+    bigint_limb carry = 0;
+    size_t groups = n / 4;
+    if (groups > 0)
+    {
+        bigint_limb t0, t1;
+        __asm__("clc\n\t"
+                "1:\n\t"
+                "mov (%[a]), %[t0]\n\t"
+                "adc (%[b]), %[t0]\n\t"
+                "mov 8(%[a]), %[t1]\n\t"
+                "adc 8(%[b]), %[t1]\n\t"
+                "mov %[t0], (%[out])\n\t"
+                "mov %[t1], 8(%[out])\n\t"
+                "mov 16(%[a]), %[t0]\n\t"
+                "adc 16(%[b]), %[t0]\n\t"
+                "mov 24(%[a]), %[t1]\n\t"
+                "adc 24(%[b]), %[t1]\n\t"
+                "mov %[t0], 16(%[out])\n\t"
+                "mov %[t1], 24(%[out])\n\t"
+                "lea 32(%[a]), %[a]\n\t"
+                "lea 32(%[b]), %[b]\n\t"
+                "lea 32(%[out]), %[out]\n\t"
+                "dec %[groups]\n\t" // leaves the carry flag alone
+                "jnz 1b\n\t"
+                "adc $0, %[carry]\n\t"
+                : [t0] "=&r"(t0), [t1] "=&r"(t1), [carry] "+&r"(carry), [a] "+&r"(a), [b] "+&r"(b),
+                  [out] "+&r"(out), [groups] "+&r"(groups)
+                :
+                : "cc", "memory");
+    }
+    for (size_t i = 0; i < n % 4; i++)
+    {
+        bigint_double_limb sum = bigint_double_limb(a[i]) + b[i] + carry;
+        out[i] = bigint_limb(sum);
+        carry = bigint_limb(sum >> bigint_limb_bits);
+    }
+    return carry;
+}
+
+/**
+ * @brief subtract two limb arrays with an unrolled sbb loop
+ *
+ * @param out n limbs for the difference, may be a or b
+ * @param a n limbs
+ * @param b n limbs to be subtracted
+ * @param n the number of limbs
+ * @return bigint_limb the borrow out of the top limb
+ */
+inline bigint_limb bigint_sub_n_x86(bigint_limb *out, const bigint_limb *a, const bigint_limb *b, size_t n)
+{
+    bigint_limb borrow = 0;
+    size_t groups = n / 4;
+    if (groups > 0)
+    {
+        bigint_limb t0, t1;
+        __asm__("clc\n\t"
+                "1:\n\t"
+                "mov (%[a]), %[t0]\n\t"
+                "sbb (%[b]), %[t0]\n\t"
+                "mov 8(%[a]), %[t1]\n\t"
+                "sbb 8(%[b]), %[t1]\n\t"
+                "mov %[t0], (%[out])\n\t"
+                "mov %[t1], 8(%[out])\n\t"
+                "mov 16(%[a]), %[t0]\n\t"
+                "sbb 16(%[b]), %[t0]\n\t"
+                "mov 24(%[a]), %[t1]\n\t"
+                "sbb 24(%[b]), %[t1]\n\t"
+                "mov %[t0], 16(%[out])\n\t"
+                "mov %[t1], 24(%[out])\n\t"
+                "lea 32(%[a]), %[a]\n\t"
+                "lea 32(%[b]), %[b]\n\t"
+                "lea 32(%[out]), %[out]\n\t"
+                "dec %[groups]\n\t" // leaves the carry flag alone
+                "jnz 1b\n\t"
+                "adc $0, %[borrow]\n\t"
+                : [t0] "=&r"(t0), [t1] "=&r"(t1), [borrow] "+&r"(borrow), [a] "+&r"(a), [b] "+&r"(b),
+                  [out] "+&r"(out), [groups] "+&r"(groups)
+                :
+                : "cc", "memory");
+    }
+    for (size_t i = 0; i < n % 4; i++)
+    {
+        bigint_limb x = a[i];
+        bigint_limb y = b[i];
+        out[i] = x - y - borrow;
+        borrow = (x < y) || (x - y < borrow);
+    }
+    return borrow;
+}
+
+/**
+ * @brief add a multiple of a limb array into another with mulx, adcx and adox
+ *
+ * mulx multiplies without touching the flags, so two carry chains run side by side: adcx
+ * adds the high half of the previous product on the carry flag, and adox adds the output
+ * limb on the overflow flag. The loop counter lives in rcx and is tested with jrcxz, which
+ * leaves both flags alone.
+ *
+ * @param out n limbs to be added to
+ * @param a n limbs
+ * @param n the number of limbs
+ * @param m a limb multiplier
+ * @return bigint_limb the carry out of the top limb
+ */
+__attribute__((target("bmi2,adx"))) inline bigint_limb bigint_addmul_1_adx(bigint_limb *out, const bigint_limb *a, size_t n, bigint_limb m)
+{
+    bigint_limb carry = 0;
+    size_t groups = n / 4;
+    if (groups > 0)
+    {
+        bigint_limb low, high, zero;
+        __asm__("xor %k[zero], %k[zero]\n\t" // clears both flags
+                "1:\n\t"
+                "mulx (%[a]), %[low], %[high]\n\t"
+                "adcx %[carry], %[low]\n\t"
+                "adox (%[out]), %[low]\n\t"
+                "mov %[low], (%[out])\n\t"
+                "mulx 8(%[a]), %[low], %[carry]\n\t"
+                "adcx %[high], %[low]\n\t"
+                "adox 8(%[out]), %[low]\n\t"
+                "mov %[low], 8(%[out])\n\t"
+                "mulx 16(%[a]), %[low], %[high]\n\t"
+                "adcx %[carry], %[low]\n\t"
+                "adox 16(%[out]), %[low]\n\t"
+                "mov %[low], 16(%[out])\n\t"
+                "mulx 24(%[a]), %[low], %[carry]\n\t"
+                "adcx %[high], %[low]\n\t"
+                "adox 24(%[out]), %[low]\n\t"
+                "mov %[low], 24(%[out])\n\t"
+                "lea 32(%[a]), %[a]\n\t"
+                "lea 32(%[out]), %[out]\n\t"
+                "lea -1(%[groups]), %[groups]\n\t"
+                "jrcxz 2f\n\t"
+                "jmp 1b\n\t"
+                "2:\n\t"
+                "adcx %[zero], %[carry]\n\t" // the product fits, so neither add overflows
+                "adox %[zero], %[carry]\n\t"
+                : [low] "=&r"(low), [high] "=&r"(high), [zero] "=&r"(zero), [carry] "+&r"(carry), [a] "+&r"(a),
+                  [out] "+&r"(out), [groups] "+c"(groups)
+                : "d"(m)
+                : "cc", "memory");
+    }
+    for (size_t i = 0; i < n % 4; i++)
+    {
+        bigint_double_limb t = bigint_double_limb(a[i]) * m + out[i] + carry;
+        out[i] = bigint_limb(t);
+        carry = bigint_limb(t >> bigint_limb_bits);
+    }
+    return carry;
+}
+
+/**
+ * @brief row-wise long multiplication of two limb arrays with the ADX addmul_1
+ *
+ * With two carry chains a row costs less than a Comba column, so the product is built by
+ * adding one row per limb of the shorter operand.
+ *
+ * @param out n + m limbs, overwritten with the product
+ * @param a n limbs, n > 0
+ * @param n the number of limbs of a
+ * @param b m limbs, m > 0
+ * @param m the number of limbs of b
+ */
+__attribute__((target("bmi2,adx"))) inline void bigint_mul_basecase_adx(bigint_limb *out, const bigint_limb *a, size_t n, const bigint_limb *b, size_t m)
+{
+    if (n < m)
+    {
+        std::swap(a, b);
+        std::swap(n, m);
+    }
+    std::fill(out, out + n + m, bigint_limb(0));
+    for (size_t j = 0; j < m; j++)
+    {
+        out[j + n] = bigint_addmul_1_adx(out + j, a, n, b[j]);
+    }
+}
+#endif
+
+/**
+ * @brief detect the instruction set extensions of the running CPU
+ *
+ * @return bigint_cpu_features the extensions the kernels may use, all false off x86-64
+ */
+inline bigint_cpu_features bigint_cpu_features::detect()
+{
+    bigint_cpu_features features;
+#if defined(BIGINT_X86_KERNELS)
+    __builtin_cpu_init(); // needed when called before main
+    features.bmi2 = __builtin_cpu_supports("bmi2");
+    features.adx = __builtin_cpu_supports("adx");
+    features.avx2 = __builtin_cpu_supports("avx2");
+    features.avx512f = __builtin_cpu_supports("avx512f");
+#endif
+    return features;
+}
+
+/**
+ * @brief choose the fastest kernels a set of features allows
+ *
+ * @param features the extensions that may be used, bigint_cpu_features{} for the portable kernels
+ * @return bigint_kernels the table of kernels
+ */
+inline bigint_kernels bigint_kernels::select(const bigint_cpu_features &features)
+{
+    bigint_kernels kernels{bigint_add_n_generic, bigint_sub_n_generic, bigint_addmul_1_generic, bigint_submul_1_generic,
+                           bigint_mul_basecase_generic, bigint_all_digits, "generic"};
+#if defined(BIGINT_X86_KERNELS)
+    kernels.add_n = bigint_add_n_x86;
+    kernels.sub_n = bigint_sub_n_x86;
+    kernels.name = "x86-64";
+    if (features.bmi2 && features.adx)
+    {
+        kernels.addmul_1 = bigint_addmul_1_adx;
+        kernels.mul_basecase = bigint_mul_basecase_adx;
+        kernels.name = "adx";
+    }
+    if (features.avx2)
+    {
+        kernels.all_digits = bigint_all_digits_avx2;
+        kernels.name = features.bmi2 && features.adx ? "adx+avx2" : "avx2";
+    }
+#else
+    (void)features;
+#endif
+    return kernels;
+}
+
+inline const bigint_kernels bigint_active_kernels = bigint_kernels::select(bigint_cpu_features::detect()); // chosen once, before main
+
+constexpr size_t bigint_small_limbs = 8; // longest operand with size-specialised kernels
+
+/**
+ * @brief add two limbs and a carry
+ *
+ * @param out set to the low limb of the sum
+ * @param a a limb
+ * @param b a limb
+ * @param carry 0 or 1
+ * @return bigint_limb the carry out, 0 or 1
+ */
+inline bigint_limb bigint_add_step(bigint_limb &out, bigint_limb a, bigint_limb b, bigint_limb carry)
+{
+#if defined(BIGINT_X86_KERNELS)
+    unsigned long long sum;
+    bigint_limb carry_out = _addcarry_u64(static_cast<unsigned char>(carry), a, b, &sum);
+    out = sum;
+    return carry_out;
+#else
+    bigint_double_limb sum = bigint_double_limb(a) + b + carry;
+    out = bigint_limb(sum);
+    return bigint_limb(sum >> bigint_limb_bits);
+#endif
+}
+
+/**
+ * @brief subtract a limb and a borrow from a limb
+ *
+ * @param out set to the low limb of the difference
+ * @param a a limb
+ * @param b a limb to be subtracted
+ * @param borrow 0 or 1
+ * @return bigint_limb the borrow out, 0 or 1
+ */
+inline bigint_limb bigint_sub_step(bigint_limb &out, bigint_limb a, bigint_limb b, bigint_limb borrow)
+{
+#if defined(BIGINT_X86_KERNELS)
+    unsigned long long difference;
+    bigint_limb borrow_out = _subborrow_u64(static_cast<unsigned char>(borrow), a, b, &difference);
+    out = difference;
+    return borrow_out;
+#else
+    out = a - b - borrow;
+    return (a < b) || (a - b < borrow);
+#endif
+}
+
+/**
+ * @brief add an M-limb array to an N-limb array, unrolled for the exact lengths
+ *
+ * @tparam N the number of limbs of a
+ * @tparam M the number of limbs of b, at most N
+ * @param out N limbs for the sum, may be a
+ * @param a N limbs
+ * @param b M limbs
+ * @return bigint_limb the carry out of the top limb
+ */
+template <size_t N, size_t M>
+bigint_limb bigint_add_fixed(bigint_limb *out, const bigint_limb *a, const bigint_limb *b)
+{
+    bigint_limb carry = 0;
+    [&]<size_t... I>(std::index_sequence<I...>)
+    {
+        ((carry = bigint_add_step(out[I], a[I], I < M ? b[I] : 0, carry)), ...);
+    }(std::make_index_sequence<N>{});
+    return carry;
+}
+
+/**
+ * @brief subtract an M-limb array from an N-limb array, unrolled for the exact lengths
+ *
+ * @tparam N the number of limbs of a
+ * @tparam M the number of limbs of b, at most N
+ * @param out N limbs for the difference, may be a
+ * @param a N limbs
+ * @param b M limbs to be subtracted
+ * @return bigint_limb the borrow out of the top limb
+ */
+template <size_t N, size_t M>
+bigint_limb bigint_sub_fixed(bigint_limb *out, const bigint_limb *a, const bigint_limb *b)
+{
+    bigint_limb borrow = 0;
+    [&]<size_t... I>(std::index_sequence<I...>)
+    {
+        ((borrow = bigint_sub_step(out[I], a[I], I < M ? b[I] : 0, borrow)), ...);
+    }(std::make_index_sequence<N>{});
+    return borrow;
+}
+
+/**
+ * @brief multiply an N-limb array by an M-limb array, unrolled for the exact lengths
+ *
+ * Each limb of b adds one row a * b[j] into the output, with the carry kept in a register.
+ *
+ * @tparam N the number of limbs of a
+ * @tparam M the number of limbs of b
+ * @param out N + M limbs for the product, not overlapping a or b
+ * @param a N limbs
+ * @param b M limbs
+ */
+template <size_t N, size_t M>
+void bigint_mul_fixed(bigint_limb *out, const bigint_limb *a, const bigint_limb *b)
+{
+    [&]<size_t... J>(std::index_sequence<J...>)
+    {
+        auto row = [&]<size_t Row, size_t... I>(std::integral_constant<size_t, Row>, std::index_sequence<I...>)
+        {
+            bigint_limb carry = 0;
+            bigint_limb m = b[Row];
+            ((carry = [&]
+              {
+                  bigint_double_limb t = bigint_double_limb(a[I]) * m + (Row == 0 ? 0 : out[I + Row]) + carry;
+                  out[I + Row] = bigint_limb(t);
+                  return bigint_limb(t >> bigint_limb_bits);
+              }()),
+             ...);
+            out[N + Row] = carry;
+        };
+        (row(std::integral_constant<size_t, J>{}, std::make_index_sequence<N>{}), ...);
+    }(std::make_index_sequence<M>{});
+}
+
+/**
+ * @brief compare two N-limb arrays, unrolled for the exact length
+ *
+ * @tparam N the number of limbs of each
+ * @param a N limbs
+ * @param b N limbs
+ * @return int -1 if a < b, 0 if they are equal, 1 if a > b
+ */
+template <size_t N>
+int bigint_cmp_fixed(const bigint_limb *a, const bigint_limb *b)
+{
+    int order = 0;
+    [&]<size_t... I>(std::index_sequence<I...>)
+    {
+        (void)((a[N - 1 - I] != b[N - 1 - I] ? (order = a[N - 1 - I] < b[N - 1 - I] ? -1 : 1, true) : false) || ...);
+    }(std::make_index_sequence<N>{});
+    return order;
+}
+
+using bigint_add_fixed_fn = bigint_limb (*)(bigint_limb *, const bigint_limb *, const bigint_limb *); // also subtraction
+using bigint_mul_fixed_fn = void (*)(bigint_limb *, const bigint_limb *, const bigint_limb *);
+using bigint_cmp_fixed_fn = int (*)(const bigint_limb *, const bigint_limb *);
+
+/**
+ * @brief a table of kernels indexed by the lengths of two operands
+ *
+ * @tparam Fn the kernel's function pointer type
+ * @param make returns the kernel for two std::integral_constant lengths, from 1 to bigint_small_limbs
+ * @return constexpr auto table[n - 1][m - 1] holding the kernel for lengths n and m
+ */
+template <typename Fn, typename Make>
+constexpr auto bigint_small_table(Make make)
+{
+    return [&]<size_t... N>(std::index_sequence<N...>)
+    {
+        auto row = [&]<size_t Row, size_t... M>(std::integral_constant<size_t, Row>, std::index_sequence<M...>)
+        {
+            return std::array<Fn, bigint_small_limbs>{make(std::integral_constant<size_t, Row + 1>{}, std::integral_constant<size_t, M + 1>{})...};
+        };
+        return std::array<std::array<Fn, bigint_small_limbs>, bigint_small_limbs>{
+            row(std::integral_constant<size_t, N>{}, std::make_index_sequence<bigint_small_limbs>{})...};
+    }(std::make_index_sequence<bigint_small_limbs>{});
+}
+
+// [n - 1][m - 1] holds the kernel for n and m limbs; addition and subtraction need m <= n
+inline constexpr auto bigint_add_small = bigint_small_table<bigint_add_fixed_fn>(
+    [](auto n, auto m) -> bigint_add_fixed_fn { return &bigint_add_fixed<n, std::min<size_t>(m, n)>; });
+inline constexpr auto bigint_sub_small = bigint_small_table<bigint_add_fixed_fn>(
+    [](auto n, auto m) -> bigint_add_fixed_fn { return &bigint_sub_fixed<n, std::min<size_t>(m, n)>; });
+inline constexpr auto bigint_mul_small = bigint_small_table<bigint_mul_fixed_fn>(
+    [](auto n, auto m) -> bigint_mul_fixed_fn { return &bigint_mul_fixed<n, m>; });
+inline constexpr std::array<bigint_cmp_fixed_fn, bigint_small_limbs> bigint_cmp_small = // [n - 1] holds the kernel for n limbs
+    []<size_t... N>(std::index_sequence<N...>)
+{
+    return std::array<bigint_cmp_fixed_fn, bigint_small_limbs>{&bigint_cmp_fixed<N + 1>...};
+}(std::make_index_sequence<bigint_small_limbs>{});
@@ -0,0 +1,234 @@
+/**
+ * @file bigint_mpn.hpp
+ * @author Shihong Cong
+ * @brief Free functions over raw limb arrays, the layer the bigint arithmetic is built on
+ * @version 0.1
+ * @date 2024-12-29
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * The functions follow the conventions of GMP's mpn layer. A number is a pointer to its limbs,
+ * least significant first, and a length, and the caller owns all memory: nothing here allocates,
+ * throws or trims leading zeros. Carries, borrows and shifted-out bits are returned rather than
+ * written past the output. Lengths are not checked, so the requirements in each comment are the
+ * caller's to meet. Calls go through the kernels chosen for the running CPU, and through the
+ * size-specialised kernels for operands of up to bigint_small_limbs limbs.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include "bigint_kernels.hpp"
+
+/**
+ * @brief add two limb arrays of equal length
+ *
+ * @param out n limbs for the sum, may be a or b
+ * @param a n limbs
+ * @param b n limbs
+ * @param n the number of limbs
+ * @return bigint_limb the carry out of the top limb, 0 or 1
+ */
+inline bigint_limb bigint_mpn_add_n(bigint_limb *out, const bigint_limb *a, const bigint_limb *b, size_t n)
+{
+    return bigint_active_kernels.add_n(out, a, b, n);
+}
+
+/**
+ * @brief subtract two limb arrays of equal length
+ *
+ * @param out n limbs for the difference, may be a or b
+ * @param a n limbs
+ * @param b n limbs to be subtracted
+ * @param n the number of limbs
+ * @return bigint_limb the borrow out of the top limb, 0 or 1
+ */
+inline bigint_limb bigint_mpn_sub_n(bigint_limb *out, const bigint_limb *a, const bigint_limb *b, size_t n)
+{
+    return bigint_active_kernels.sub_n(out, a, b, n);
+}
+
+/**
+ * @brief add a limb array to one at least as long
+ *
+ * When out is a, the carry stops at the first limb it leaves unchanged, so adding a short array
+ * into a long one costs the length of the short one.
+ *
+ * @param out n limbs for the sum, may be a
+ * @param a n limbs
+ * @param n the number of limbs of a
+ * @param b m limbs
+ * @param m the number of limbs of b, m <= n
+ * @return bigint_limb the carry out of the top limb, 0 or 1
+ */
+inline bigint_limb bigint_mpn_add(bigint_limb *out, const bigint_limb *a, size_t n, const bigint_limb *b, size_t m)
+{
+    if (n <= bigint_small_limbs && m > 0)
+    {
+        return bigint_add_small[n - 1][m - 1](out, a, b);
+    }
+    bigint_limb carry = bigint_mpn_add_n(out, a, b, m);
+    size_t i = m;
+    for (; i < n && carry != 0; i++)
+    {
+        out[i] = a[i] + 1;
+        carry = out[i] == 0 ? 1 : 0;
+    }
+    if (out != a)
+    {
+        std::copy(a + i, a + n, out + i);
+    }
+    return carry;
+}
+
+/**
+ * @brief subtract a limb array from one at least as long
+ *
+ * When out is a, the borrow stops at the first limb it leaves unchanged.
+ *
+ * @param out n limbs for the difference, may be a
+ * @param a n limbs
+ * @param n the number of limbs of a
+ * @param b m limbs to be subtracted
+ * @param m the number of limbs of b, m <= n
+ * @return bigint_limb the borrow out of the top limb, 0 or 1
+ */
+inline bigint_limb bigint_mpn_sub(bigint_limb *out, const bigint_limb *a, size_t n, const bigint_limb *b, size_t m)
+{
+    if (n <= bigint_small_limbs && m > 0)
+    {
+        return bigint_sub_small[n - 1][m - 1](out, a, b);
+    }
+    bigint_limb borrow = bigint_mpn_sub_n(out, a, b, m);
+    size_t i = m;
+    for (; i < n && borrow != 0; i++)
+    {
+        borrow = a[i] == 0 ? 1 : 0;
+        out[i] = a[i] - 1;
+    }
+    if (out != a)
+    {
+        std::copy(a + i, a + n, out + i);
+    }
+    return borrow;
+}
+
+/**
+ * @brief add the product of a limb array and one limb into another limb array
+ *
+ * @param out n limbs to be added to, not overlapping a
+ * @param a n limbs
+ * @param n the number of limbs
+ * @param m the limb to multiply by
+ * @return bigint_limb the limb carried out of the top of out
+ */
+inline bigint_limb bigint_mpn_addmul_1(bigint_limb *out, const bigint_limb *a, size_t n, bigint_limb m)
+{
+    return bigint_active_kernels.addmul_1(out, a, n, m);
+}
+
+/**
+ * @brief subtract the product of a limb array and one limb from another limb array
+ *
+ * @param out n limbs to be subtracted from, not overlapping a
+ * @param a n limbs
+ * @param n the number of limbs
+ * @param m the limb to multiply by
+ * @return bigint_limb the limb borrowed from above the top of out
+ */
+inline bigint_limb bigint_mpn_submul_1(bigint_limb *out, const bigint_limb *a, size_t n, bigint_limb m)
+{
+    return bigint_active_kernels.submul_1(out, a, n, m);
+}
+
+/**
+ * @brief multiply two limb arrays by long multiplication
+ *
+ * This takes O(n * m) time, which is the fastest method below bigint_active_thresholds.karatsuba
+ * limbs; the bigint operators switch to Karatsuba's method above it.
+ *
+ * @param out n + m limbs, overwritten with the product, not overlapping a or b
+ * @param a n limbs
+ * @param n the number of limbs of a, n > 0
+ * @param b m limbs
+ * @param m the number of limbs of b, m > 0
+ */
+inline void bigint_mpn_mul_basecase(bigint_limb *out, const bigint_limb *a, size_t n, const bigint_limb *b, size_t m)
+{
+    if (n <= bigint_small_limbs && m <= bigint_small_limbs)
+    {
+        bigint_mul_small[n - 1][m - 1](out, a, b);
+    }
+    else
+    {
+        bigint_active_kernels.mul_basecase(out, a, n, b, m);
+    }
+}
+
+/**
+ * @brief compare two limb arrays of equal length
+ *
+ * @param a n limbs
+ * @param b n limbs
+ * @param n the number of limbs
+ * @return int -1 if a < b, 0 if they are equal, 1 if a > b
+ */
+inline int bigint_mpn_cmp(const bigint_limb *a, const bigint_limb *b, size_t n)
+{
+    if (n > 0 && n <= bigint_small_limbs)
+    {
+        return bigint_cmp_small[n - 1](a, b);
+    }
+    for (size_t i = n; i > 0; i--)
+    {
+        if (a[i - 1] != b[i - 1])
+        {
+            return a[i - 1] < b[i - 1] ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief shift a limb array towards its top by fewer bits than a limb
+ *
+ * The limbs are written from the top down, so out may be a or overlap it from above.
+ *
+ * @param out n limbs for the shifted value
+ * @param a n limbs
+ * @param n the number of limbs, n > 0
+ * @param count the number of bits, 0 < count < 64
+ * @return bigint_limb the bits shifted out of the top limb, in the low bits of the result
+ */
+inline bigint_limb bigint_mpn_lshift(bigint_limb *out, const bigint_limb *a, size_t n, unsigned count)
+{
+    bigint_limb high = a[n - 1] >> (bigint_limb_bits - count);
+    for (size_t i = n - 1; i > 0; i--)
+    {
+        out[i] = (a[i] << count) | (a[i - 1] >> (bigint_limb_bits - count));
+    }
+    out[0] = a[0] << count;
+    return high;
+}
+
+/**
+ * @brief shift a limb array towards its bottom by fewer bits than a limb
+ *
+ * The limbs are written from the bottom up, so out may be a or overlap it from below.
+ *
+ * @param out n limbs for the shifted value
+ * @param a n limbs
+ * @param n the number of limbs, n > 0
+ * @param count the number of bits, 0 < count < 64
+ * @return bigint_limb the bits shifted out of the bottom limb, in the high bits of the result
+ */
+inline bigint_limb bigint_mpn_rshift(bigint_limb *out, const bigint_limb *a, size_t n, unsigned count)
+{
+    bigint_limb low = a[0] << (bigint_limb_bits - count);
+    for (size_t i = 0; i + 1 < n; i++)
+    {
+        out[i] = (a[i] >> count) | (a[i + 1] << (bigint_limb_bits - count));
+    }
+    out[n - 1] = a[n - 1] >> count;
+    return low;
+}
@@ -0,0 +1,260 @@
+/**
+ * @file bigint_parallel.hpp
+ * @author Shihong Cong
+ * @brief Sums and products of large collections of bigints, split across threads
+ * @version 0.1
+ * @date 2024-12-29
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <future>
+#include <iterator>
+#include <span>
+#include <thread>
+#include <vector>
+#include "bigint.hpp"
+
+constexpr size_t bigint_parallel_min_sum = 4096;   // fewest values per thread worth starting a thread for a sum
+constexpr size_t bigint_parallel_min_product = 64; // fewest values per thread worth starting a thread for a product
+
+template <typename It>
+concept bigint_view_iterator = std::random_access_iterator<It> && std::convertible_to<std::iter_reference_t<It>, bigint_view>;
+
+template <bigint_view_iterator It>
+bigint parallel_sum(It, It, unsigned = 0); // sum of a range, 0 threads means one per hardware thread
+template <bigint_view_iterator It>
+bigint parallel_product(It, It, unsigned = 0); // product of a range, 0 threads means one per hardware thread
+
+/**
+ * @brief a sum that defers every carry until the end
+ *
+ * Each limb of each value is added into its own 128-bit column, positive and negative values
+ * into separate columns, so adding a value is one independent addition per limb with no carry
+ * chain and no allocation once the columns are long enough. The carries are propagated once,
+ * in value(). A column overflows only after 2^64 values, which is never reached in practice.
+ */
+class bigint_deferred_sum
+{
+public:
+    void add(bigint_view); // add a value to the columns
+    bigint value() const;  // the sum, with the carries propagated
+
+private:
+    std::vector<bigint_double_limb> positive; // column sums of the positive values
+    std::vector<bigint_double_limb> negative; // column sums of the magnitudes of the negative values
+
+    static bigint normalise(const std::vector<bigint_double_limb> &); // propagate the carries of the columns
+};
+
+/**
+ * @brief add a value to the columns
+ *
+ * @param num a view to be added
+ */
+inline void bigint_deferred_sum::add(bigint_view num)
+{
+    num = num.trimmed();
+    std::vector<bigint_double_limb> &columns = num.negative() ? negative : positive;
+    if (columns.size() < num.size())
+    {
+        columns.resize(num.size(), 0);
+    }
+    std::span<const bigint_limb> limbs = num.limbs();
+    for (size_t i = 0; i < limbs.size(); i++)
+    {
+        columns[i] += limbs[i];
+    }
+}
+
+/**
+ * @brief a helper function to propagate the carries of a set of columns
+ *
+ * @param columns column sums, least significant first
+ * @return bigint the non-negative number the columns add up to
+ */
+inline bigint bigint_deferred_sum::normalise(const std::vector<bigint_double_limb> &columns)
+{
+    std::vector<bigint_limb> limbs;
+    limbs.reserve(columns.size() + 2);
+    bigint_double_limb carry = 0;
+    for (bigint_double_limb column : columns)
+    {
+        // column < 2^128 - 2^64 and carry < 2^64, so the sum does not wrap
+        bigint_double_limb sum = column + carry;
+        limbs.push_back(bigint_limb(sum));
+        carry = sum >> bigint_limb_bits;
+    }
+    while (carry != 0)
+    {
+        limbs.push_back(bigint_limb(carry));
+        carry >>= bigint_limb_bits;
+    }
+    return bigint(bigint_view(limbs));
+}
+
+/**
+ * @brief the sum of every value added
+ *
+ * @return bigint the sum
+ */
+inline bigint bigint_deferred_sum::value() const
+{
+    return normalise(positive) - normalise(negative);
+}
+
+/**
+ * @brief combine values pairwise, level by level, until one is left
+ *
+ * The pairs of each level are combined in parallel, so the operands of every combination have
+ * similar sizes and the largest combinations at the top are not left to one thread.
+ *
+ * @tparam Op a callable taking two bigints and returning a bigint
+ * @param values the values to combine, at least one
+ * @param combine the operation, associative
+ * @return bigint the combination of all values
+ */
+template <typename Op>
+bigint bigint_parallel_tree(std::vector<bigint> values, Op combine)
+{
+    while (values.size() > 1)
+    {
+        std::vector<std::future<bigint>> pairs;
+        for (size_t i = 0; i + 1 < values.size(); i += 2)
+        {
+            pairs.push_back(std::async(std::launch::async, [&, i] { return combine(values[i], values[i + 1]); }));
+        }
+        std::vector<bigint> next;
+        next.reserve((values.size() + 1) / 2);
+        for (std::future<bigint> &pair : pairs)
+        {
+            next.push_back(pair.get());
+        }
+        if (values.size() % 2 != 0)
+        {
+            next.push_back(std::move(values.back()));
+        }
+        values = std::move(next);
+    }
+    return std::move(values[0]);
+}
+
+/**
+ * @brief choose how many threads to split a range across
+ *
+ * @param count the number of values
+ * @param threads the requested number of threads, 0 for one per hardware thread
+ * @param min_per_thread the fewest values worth a thread
+ * @return size_t the number of threads, at least 1
+ */
+inline size_t bigint_parallel_threads(size_t count, unsigned threads, size_t min_per_thread)
+{
+    size_t wanted = threads != 0 ? threads : std::max(1u, std::thread::hardware_concurrency());
+    return std::max<size_t>(1, std::min(wanted, count / min_per_thread));
+}
+
+/**
+ * @brief add up a range of values, splitting it across threads
+ *
+ * Each thread adds its share into a bigint_deferred_sum, which defers every carry, and the
+ * partial sums are then added pairwise. Ranges too short to be worth a thread per
+ * bigint_parallel_min_sum values are added on the calling thread. Exceptions thrown by a
+ * thread are rethrown.
+ *
+ * @tparam It a random access iterator over values convertible to bigint_view
+ * @param first the first value
+ * @param last one past the last value
+ * @param threads the number of threads, 0 for one per hardware thread
+ * @return bigint the sum, 0 for an empty range
+ */
+template <bigint_view_iterator It>
+bigint parallel_sum(It first, It last, unsigned threads)
+{
+    auto sum_range = [](It begin, It end)
+    {
+        bigint_deferred_sum sum;
+        for (It it = begin; it != end; ++it)
+        {
+            sum.add(*it);
+        }
+        return sum.value();
+    };
+
+    size_t count = size_t(last - first);
+    size_t parts = bigint_parallel_threads(count, threads, bigint_parallel_min_sum);
+    if (parts == 1)
+    {
+        return sum_range(first, last);
+    }
+    std::vector<std::future<bigint>> futures;
+    for (size_t part = 0; part < parts; part++)
+    {
+        It begin = first + std::iter_difference_t<It>(count * part / parts);
+        It end = first + std::iter_difference_t<It>(count * (part + 1) / parts);
+        futures.push_back(std::async(std::launch::async, sum_range, begin, end));
+    }
+    std::vector<bigint> partials;
+    for (std::future<bigint> &future : futures)
+    {
+        partials.push_back(future.get());
+    }
+    return bigint_parallel_tree(std::move(partials), [](const bigint &a, const bigint &b) { return a + b; });
+}
+
+/**
+ * @brief multiply a range of values, splitting it across threads
+ *
+ * Each thread multiplies its share as a balanced tree, halves first, so that every
+ * multiplication has operands of similar size and Karatsuba multiplication applies, and the
+ * partial products are then multiplied pairwise, in parallel. Multiplying left to right
+ * instead would make each step a multiplication of a growing product by one small value.
+ * Ranges too short to be worth a thread per bigint_parallel_min_product values are multiplied
+ * on the calling thread.
+ *
+ * @tparam It a random access iterator over values convertible to bigint_view
+ * @param first the first value
+ * @param last one past the last value
+ * @param threads the number of threads, 0 for one per hardware thread
+ * @return bigint the product, 1 for an empty range
+ */
+template <bigint_view_iterator It>
+bigint parallel_product(It first, It last, unsigned threads)
+{
+    auto product_range = [](const auto &self, It begin, It end) -> bigint
+    {
+        if (end - begin == 0)
+        {
+            return bigint(1);
+        }
+        if (end - begin == 1)
+        {
+            return bigint(bigint_view(*begin));
+        }
+        It middle = begin + (end - begin) / 2;
+        return self(self, begin, middle) * self(self, middle, end);
+    };
+
+    size_t count = size_t(last - first);
+    size_t parts = bigint_parallel_threads(count, threads, bigint_parallel_min_product);
+    if (parts == 1)
+    {
+        return product_range(product_range, first, last);
+    }
+    std::vector<std::future<bigint>> futures;
+    for (size_t part = 0; part < parts; part++)
+    {
+        It begin = first + std::iter_difference_t<It>(count * part / parts);
+        It end = first + std::iter_difference_t<It>(count * (part + 1) / parts);
+        futures.push_back(std::async(std::launch::async, product_range, product_range, begin, end));
+    }
+    std::vector<bigint> partials;
+    for (std::future<bigint> &future : futures)
+    {
+        partials.push_back(future.get());
+    }
+    return bigint_parallel_tree(std::move(partials), [](const bigint &a, const bigint &b) { return a * b; });
+}
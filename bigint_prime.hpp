@@ -0,0 +1,765 @@
+/**
+ * @file bigint_prime.hpp
+ * @author Shihong Cong
+ * @brief Random bigints, Montgomery arithmetic and probabilistic primality testing
+ * @version 0.1
+ * @date 2024-12-29
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "bigint.hpp"
+
+/**
+ * @brief arithmetic modulo an odd number in Montgomery form
+ *
+ * A residue x is stored as x * R mod n with R = 2^(64k) for a k-limb modulus n, so a
+ * product needs one interleaved multiply-and-reduce pass (FIOS) instead of a division.
+ * Residues are vectors of exactly k limbs, little endian, each below n.
+ */
+class bigint_montgomery
+{
+public:
+    using residue = std::vector<bigint_limb>; // k limbs in Montgomery form
+
+    // Constructors
+    explicit bigint_montgomery(bigint_view); // modulus, odd and greater than 1
+
+    // conversion
+    residue to_montgomery(bigint_view) const;      // x * R mod n for 0 <= x < n
+    bigint from_montgomery(const residue &) const; // the value of a residue
+    residue from_small(int64_t) const;             // a small signed integer mod n, |x| < n
+
+    // arithmetic
+    residue multiply(const residue &, const residue &) const; // a * b mod n
+    residue add(const residue &, const residue &) const;      // a + b mod n
+    residue subtract(const residue &, const residue &) const; // a - b mod n
+    residue half(const residue &) const;                      // a / 2 mod n
+    residue pow(const residue &, bigint_view) const;          // a^e mod n, e >= 0
+
+    const residue &one() const;       // 1 in Montgomery form
+    const residue &minus_one() const; // n - 1 in Montgomery form
+    size_t size() const;              // number of limbs k
+
+private:
+    residue modulus;     // n
+    residue r_mod;       // R mod n, 1 in Montgomery form
+    residue r_squared;   // R^2 mod n, converts into Montgomery form
+    residue r_minus;     // n - (R mod n), -1 in Montgomery form
+    bigint_limb n_prime; // -n^-1 mod 2^64
+
+    bool is_less(const residue &) const;    // true if a value of k limbs is below n
+    void subtract_modulus(residue &) const; // a -= n, a >= n
+    void double_mod(residue &) const;       // a = 2a mod n
+};
+
+// primes and random numbers
+template <typename Rng>
+bigint random_bigint(size_t, Rng &);             // uniform in [0, 2^bits)
+bool is_probable_prime(bigint_view, size_t = 0); // trial division, then BPSW, then extra Miller-Rabin rounds
+bigint next_prime(bigint_view);                  // smallest prime greater than a number
+
+/**
+ * @brief the odd primes below 2^16, found with a sieve at compile time
+ *
+ * is_probable_prime divides by the ones below 2000, and next_prime sieves with all of them.
+ */
+inline constexpr std::array<uint32_t, 6541> bigint_small_primes = []
+{
+    constexpr size_t limit = 65536;
+    std::array<bool, limit> composite{};
+    std::array<uint32_t, 6541> primes{};
+    for (size_t i = 3, count = 0; i < limit; i += 2)
+    {
+        if (!composite[i])
+        {
+            primes[count++] = uint32_t(i);
+            for (size_t j = i * i; j < limit; j += 2 * i)
+            {
+                composite[j] = true;
+            }
+        }
+    }
+    return primes;
+}();
+inline constexpr size_t bigint_trial_primes = 302; // number of odd primes below 2000
+
+/**
+ * @brief Construct a new bigint_montgomery object
+ *
+ * R mod n and R^2 mod n are found by doubling 1 modulo n, which needs no division.
+ *
+ * @param n an odd modulus greater than 1, its sign is ignored
+ */
+inline bigint_montgomery::bigint_montgomery(bigint_view n)
+{
+    n = n.trimmed();
+    if (n.size() == 0 || n[0] % 2 == 0 || (n.size() == 1 && n[0] == 1))
+    {
+        throw std::invalid_argument("Montgomery modulus must be odd and greater than 1");
+    }
+    modulus.assign(n.limbs().begin(), n.limbs().end());
+
+    // Newton's iteration doubles the correct low bits of the inverse, starting from 3
+    bigint_limb inverse = modulus[0];
+    for (int i = 0; i < 5; i++)
+    {
+        inverse *= 2 - modulus[0] * inverse;
+    }
+    n_prime = 0 - inverse;
+
+    residue x(size(), 0);
+    x[0] = 1;
+    for (size_t i = 0; i < size() * bigint_limb_bits; i++)
+    {
+        double_mod(x);
+    }
+    r_mod = x;
+    for (size_t i = 0; i < size() * bigint_limb_bits; i++)
+    {
+        double_mod(x);
+    }
+    r_squared = x;
+    r_minus = subtract(residue(size(), 0), r_mod);
+}
+
+/**
+ * @brief the number of limbs of the modulus
+ *
+ * @return size_t k
+ */
+inline size_t bigint_montgomery::size() const
+{
+    return modulus.size();
+}
+
+/**
+ * @brief 1 in Montgomery form
+ *
+ * @return const residue& R mod n
+ */
+inline const bigint_montgomery::residue &bigint_montgomery::one() const
+{
+    return r_mod;
+}
+
+/**
+ * @brief -1 in Montgomery form
+ *
+ * @return const residue& n - (R mod n)
+ */
+inline const bigint_montgomery::residue &bigint_montgomery::minus_one() const
+{
+    return r_minus;
+}
+
+/**
+ * @brief a helper function to compare a value of k limbs with the modulus
+ *
+ * @param a a value of k limbs
+ * @return true if a < n
+ */
+inline bool bigint_montgomery::is_less(const residue &a) const
+{
+    for (size_t i = size(); i > 0; i--)
+    {
+        if (a[i - 1] != modulus[i - 1])
+        {
+            return a[i - 1] < modulus[i - 1];
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief a helper function to subtract the modulus in place, ignoring the final borrow
+ *
+ * @param a a value of k limbs that is at least n, or that overflowed k limbs by one bit
+ */
+inline void bigint_montgomery::subtract_modulus(residue &a) const
+{
+    bigint_limb borrow = 0;
+    for (size_t i = 0; i < size(); i++)
+    {
+        bigint_limb diff = a[i] - modulus[i];
+        bigint_limb borrow_out = a[i] < modulus[i] || diff < borrow ? 1 : 0;
+        a[i] = diff - borrow;
+        borrow = borrow_out;
+    }
+}
+
+/**
+ * @brief a helper function to double a value modulo n in place
+ *
+ * @param a a value below n
+ */
+inline void bigint_montgomery::double_mod(residue &a) const
+{
+    bigint_limb high = 0;
+    for (bigint_limb &limb : a)
+    {
+        bigint_limb next = limb >> (bigint_limb_bits - 1);
+        limb = (limb << 1) | high;
+        high = next;
+    }
+    if (high != 0 || !is_less(a))
+    {
+        subtract_modulus(a);
+    }
+}
+
+/**
+ * @brief multiply two residues with the finely integrated operand scanning (FIOS) method
+ *
+ * Each row adds a * b[i] and a multiple m of n chosen to clear the lowest limb in the same
+ * pass, so the running sum shifts down one limb per row and never grows past k + 1 limbs.
+ *
+ * @param a a residue
+ * @param b a residue
+ * @return residue a * b / R mod n, the Montgomery form of the product
+ */
+inline bigint_montgomery::residue bigint_montgomery::multiply(const residue &a, const residue &b) const
+{
+    size_t k = size();
+    residue t(k + 1, 0);
+    const bigint_limb *n = modulus.data();
+    for (size_t i = 0; i < k; i++)
+    {
+        bigint_limb bi = b[i];
+        bigint_double_limb product = bigint_double_limb(a[0]) * bi + t[0];
+        bigint_limb m = bigint_limb(product) * n_prime;
+        bigint_double_limb reduced = bigint_double_limb(m) * n[0] + bigint_limb(product);
+        bigint_limb carry = bigint_limb(product >> bigint_limb_bits);
+        bigint_limb reduce_carry = bigint_limb(reduced >> bigint_limb_bits);
+        for (size_t j = 1; j < k; j++)
+        {
+            product = bigint_double_limb(a[j]) * bi + t[j] + carry;
+            reduced = bigint_double_limb(m) * n[j] + bigint_limb(product) + reduce_carry;
+            carry = bigint_limb(product >> bigint_limb_bits);
+            reduce_carry = bigint_limb(reduced >> bigint_limb_bits);
+            t[j - 1] = bigint_limb(reduced);
+        }
+        bigint_double_limb top = bigint_double_limb(t[k]) + carry + reduce_carry;
+        t[k - 1] = bigint_limb(top);
+        t[k] = bigint_limb(top >> bigint_limb_bits);
+    }
+
+    bool overflow = t[k] != 0;
+    t.resize(k);
+    if (overflow || !is_less(t))
+    {
+        subtract_modulus(t);
+    }
+    return t;
+}
+
+/**
+ * @brief add two residues
+ *
+ * @param a a residue
+ * @param b a residue
+ * @return residue a + b mod n
+ */
+inline bigint_montgomery::residue bigint_montgomery::add(const residue &a, const residue &b) const
+{
+    residue result(size());
+    bigint_limb carry = 0;
+    for (size_t i = 0; i < size(); i++)
+    {
+        bigint_double_limb sum = bigint_double_limb(a[i]) + b[i] + carry;
+        result[i] = bigint_limb(sum);
+        carry = bigint_limb(sum >> bigint_limb_bits);
+    }
+    if (carry != 0 || !is_less(result))
+    {
+        subtract_modulus(result);
+    }
+    return result;
+}
+
+/**
+ * @brief subtract two residues
+ *
+ * @param a a residue
+ * @param b a residue to be subtracted
+ * @return residue a - b mod n
+ */
+inline bigint_montgomery::residue bigint_montgomery::subtract(const residue &a, const residue &b) const
+{
+    residue result(size());
+    bigint_limb borrow = 0;
+    for (size_t i = 0; i < size(); i++)
+    {
+        bigint_limb diff = a[i] - b[i];
+        bigint_limb borrow_out = a[i] < b[i] || diff < borrow ? 1 : 0;
+        result[i] = diff - borrow;
+        borrow = borrow_out;
+    }
+    if (borrow != 0)
+    {
+        bigint_limb carry = 0;
+        for (size_t i = 0; i < size(); i++)
+        {
+            bigint_double_limb sum = bigint_double_limb(result[i]) + modulus[i] + carry;
+            result[i] = bigint_limb(sum);
+            carry = bigint_limb(sum >> bigint_limb_bits);
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief halve a residue, halving commutes with the Montgomery form
+ *
+ * @param a a residue
+ * @return residue a / 2 mod n, computed as a / 2 or (a + n) / 2 for odd a
+ */
+inline bigint_montgomery::residue bigint_montgomery::half(const residue &a) const
+{
+    residue result = a;
+    bigint_limb carry = 0;
+    if (a[0] % 2 == 1)
+    {
+        for (size_t i = 0; i < size(); i++)
+        {
+            bigint_double_limb sum = bigint_double_limb(result[i]) + modulus[i] + carry;
+            result[i] = bigint_limb(sum);
+            carry = bigint_limb(sum >> bigint_limb_bits);
+        }
+    }
+    for (size_t i = 0; i < size(); i++)
+    {
+        bigint_limb high = i + 1 < size() ? result[i + 1] : carry;
+        result[i] = (result[i] >> 1) | (high << (bigint_limb_bits - 1));
+    }
+    return result;
+}
+
+/**
+ * @brief convert a value into Montgomery form
+ *
+ * @param x a value with 0 <= x < n, its sign is ignored
+ * @return residue x * R mod n
+ */
+inline bigint_montgomery::residue bigint_montgomery::to_montgomery(bigint_view x) const
+{
+    x = x.trimmed();
+    if (x.size() > size())
+    {
+        throw std::invalid_argument("Value is not reduced modulo the Montgomery modulus");
+    }
+    residue a(size(), 0);
+    std::copy(x.limbs().begin(), x.limbs().end(), a.begin());
+    if (!is_less(a))
+    {
+        throw std::invalid_argument("Value is not reduced modulo the Montgomery modulus");
+    }
+    return multiply(a, r_squared);
+}
+
+/**
+ * @brief convert a small signed integer into Montgomery form
+ *
+ * @param x a value with |x| < n
+ * @return residue x * R mod n
+ */
+inline bigint_montgomery::residue bigint_montgomery::from_small(int64_t x) const
+{
+    residue magnitude = to_montgomery(bigint(x < 0 ? -bigint(x) : bigint(x)));
+    return x < 0 ? subtract(residue(size(), 0), magnitude) : magnitude;
+}
+
+/**
+ * @brief convert a residue out of Montgomery form
+ *
+ * @param a a residue
+ * @return bigint the value a / R mod n
+ */
+inline bigint bigint_montgomery::from_montgomery(const residue &a) const
+{
+    residue unit(size(), 0);
+    unit[0] = 1;
+    residue value = multiply(a, unit);
+    return bigint(bigint_view(value));
+}
+
+/**
+ * @brief raise a residue to a power with a fixed 4-bit window
+ *
+ * @param a a residue
+ * @param exp a non-negative exponent
+ * @return residue a^exp mod n
+ */
+inline bigint_montgomery::residue bigint_montgomery::pow(const residue &a, bigint_view exp) const
+{
+    std::array<residue, 16> powers;
+    powers[0] = r_mod;
+    for (size_t i = 1; i < powers.size(); i++)
+    {
+        powers[i] = multiply(powers[i - 1], a);
+    }
+
+    residue result = r_mod;
+    for (size_t i = (exp.bit_length() + 3) / 4; i > 0; i--)
+    {
+        size_t shift = (i - 1) * 4;
+        size_t nibble = size_t(exp[shift / bigint_limb_bits] >> (shift % bigint_limb_bits)) & 15;
+        if (result != r_mod)
+        {
+            for (int j = 0; j < 4; j++)
+            {
+                result = multiply(result, result);
+            }
+        }
+        if (nibble != 0)
+        {
+            result = multiply(result, powers[nibble]);
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief generate a uniformly random number of at most a given number of bits
+ *
+ * Set the top bit of the result to get exactly bits bits, for example to seed next_prime.
+ *
+ * @tparam Rng a uniform random bit generator, such as std::mt19937_64
+ * @param bits the number of random bits
+ * @param rng the random number generator
+ * @return bigint a number in [0, 2^bits)
+ */
+template <typename Rng>
+bigint random_bigint(size_t bits, Rng &rng)
+{
+    std::uniform_int_distribution<bigint_limb> limb;
+    std::vector<bigint_limb> limbs((bits + bigint_limb_bits - 1) / bigint_limb_bits);
+    for (bigint_limb &value : limbs)
+    {
+        value = limb(rng);
+    }
+    if (bits % bigint_limb_bits != 0)
+    {
+        limbs.back() &= (bigint_limb(1) << (bits % bigint_limb_bits)) - 1;
+    }
+    return bigint(bigint_view(limbs));
+}
+
+/**
+ * @brief a helper function to compute the Jacobi symbol (a/n) of two native integers
+ *
+ * @param a a non-negative integer
+ * @param n an odd positive integer
+ * @return int -1, 0 or 1
+ */
+inline int bigint_jacobi(uint64_t a, uint64_t n)
+{
+    int result = 1;
+    a %= n;
+    while (a != 0)
+    {
+        while (a % 2 == 0)
+        {
+            a /= 2;
+            if (n % 8 == 3 || n % 8 == 5)
+            {
+                result = -result;
+            }
+        }
+        std::swap(a, n);
+        if (a % 4 == 3 && n % 4 == 3)
+        {
+            result = -result;
+        }
+        a %= n;
+    }
+    return n == 1 ? result : 0;
+}
+
+/**
+ * @brief a helper function to test whether a number is a perfect square
+ *
+ * Quadratic residues modulo 64, 63, 65 and 11 reject almost every non-square before the
+ * integer square root is computed digit by digit.
+ *
+ * @param n a non-negative number
+ * @return true if n is a square
+ */
+inline bool bigint_is_square(bigint_view n)
+{
+    constexpr std::array<uint64_t, 4> filters = {64, 63, 65, 11};
+    bigint value(n.abs());
+    for (uint64_t modulus : filters)
+    {
+        uint64_t r = bigint_view(value % modulus)[0];
+        bool residue = false;
+        for (uint64_t x = 0; x < modulus && !residue; x++)
+        {
+            residue = x * x % modulus == r;
+        }
+        if (!residue)
+        {
+            return false;
+        }
+    }
+
+    bigint remainder = value;
+    bigint root;
+    size_t top = value.bit_length() == 0 ? 0 : (value.bit_length() - 1) & ~size_t(1);
+    bigint bit = bigint(1) << top;
+    while (bit != 0)
+    {
+        bigint candidate = root + bit;
+        if (remainder >= candidate)
+        {
+            remainder -= candidate;
+            root = (root >> 1) + bit;
+        }
+        else
+        {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return remainder == 0;
+}
+
+/**
+ * @brief a helper function for one strong probable prime (Miller-Rabin) round
+ *
+ * @param mont arithmetic modulo the odd candidate n
+ * @param base a residue of the base
+ * @param d the odd part of n - 1
+ * @param s the number of factors 2 in n - 1
+ * @return true if n is a strong probable prime to the base
+ */
+inline bool bigint_miller_rabin(const bigint_montgomery &mont, const bigint_montgomery::residue &base, bigint_view d, size_t s)
+{
+    bigint_montgomery::residue x = mont.pow(base, d);
+    if (x == mont.one() || x == mont.minus_one())
+    {
+        return true;
+    }
+    for (size_t i = 1; i < s; i++)
+    {
+        x = mont.multiply(x, x);
+        if (x == mont.minus_one())
+        {
+            return true;
+        }
+        if (x == mont.one())
+        {
+            return false;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief a helper function for the strong Lucas probable prime test with Selfridge's parameters
+ *
+ * D is the first of 5, -7, 9, -11, ... with Jacobi symbol (D/n) = -1, P = 1 and Q = (1 - D) / 4.
+ * U and V are evaluated at the odd part d of n + 1 with the doubling formulas, and n passes if
+ * U_d = 0 or V_(d 2^r) = 0 for some 0 <= r < s.
+ *
+ * @param mont arithmetic modulo the odd candidate n
+ * @param n the candidate, odd, not a square and free of factors below 2000
+ * @return true if n is a strong Lucas probable prime
+ */
+inline bool bigint_strong_lucas(const bigint_montgomery &mont, bigint_view n)
+{
+    int64_t d_value = 5;
+    bool n_is_3_mod_4 = n[0] % 4 == 3;
+    for (;;)
+    {
+        uint64_t magnitude = uint64_t(d_value < 0 ? -d_value : d_value);
+        int jacobi = bigint_jacobi(bigint_view(bigint(n) % magnitude)[0], magnitude); // (n / |D|)
+        if (n_is_3_mod_4 && magnitude % 4 == 3)
+        {
+            jacobi = -jacobi; // quadratic reciprocity gives (|D| / n)
+        }
+        if (d_value < 0 && n_is_3_mod_4)
+        {
+            jacobi = -jacobi; // (-1 / n)
+        }
+        if (jacobi == 0)
+        {
+            return false; // |D| shares a factor with n, which is larger than |D|
+        }
+        if (jacobi == -1)
+        {
+            break;
+        }
+        if (d_value == 17 && bigint_is_square(n))
+        {
+            return false; // squares never give -1, so stop searching
+        }
+        d_value = d_value < 0 ? -d_value + 2 : -d_value - 2;
+    }
+
+    bigint n_plus_one = bigint(n) + 1;
+    size_t s = n_plus_one.countr_zero();
+    bigint d = n_plus_one >> s;
+
+    bigint_montgomery::residue big_d = mont.from_small(d_value);
+    bigint_montgomery::residue q = mont.from_small((1 - d_value) / 4);
+    bigint_montgomery::residue u = mont.one();
+    bigint_montgomery::residue v = mont.one();
+    bigint_montgomery::residue q_k = q;
+    for (size_t i = d.bit_length() - 1; i > 0; i--)
+    {
+        u = mont.multiply(u, v);
+        v = mont.subtract(mont.multiply(v, v), mont.add(q_k, q_k));
+        q_k = mont.multiply(q_k, q_k);
+        if ((bigint_view(d)[(i - 1) / bigint_limb_bits] >> ((i - 1) % bigint_limb_bits)) & 1)
+        {
+            bigint_montgomery::residue next_u = mont.half(mont.add(u, v));
+            v = mont.half(mont.add(mont.multiply(big_d, u), v));
+            u = next_u;
+            q_k = mont.multiply(q_k, q);
+        }
+    }
+
+    bigint_montgomery::residue zero(mont.size(), 0);
+    if (u == zero || v == zero)
+    {
+        return true;
+    }
+    for (size_t r = 1; r < s; r++)
+    {
+        v = mont.subtract(mont.multiply(v, v), mont.add(q_k, q_k));
+        if (v == zero)
+        {
+            return true;
+        }
+        q_k = mont.multiply(q_k, q_k);
+    }
+    return false;
+}
+
+/**
+ * @brief test whether a number is probably prime
+ *
+ * Small factors are found by trial division by the odd primes below 2000, grouped so that
+ * one single-limb remainder of the number serves several primes. The remaining candidates go
+ * through the Baillie-PSW test, a Miller-Rabin round to base 2 and a strong Lucas test, which
+ * has no known counterexample, and then through the requested number of extra Miller-Rabin
+ * rounds to the bases 3, 5, 7, ...
+ *
+ * @param n a number, negative numbers, 0 and 1 are not prime
+ * @param rounds extra Miller-Rabin rounds after BPSW
+ * @return true if n is prime or a BPSW pseudoprime, false if n is composite
+ */
+inline bool is_probable_prime(bigint_view n, size_t rounds)
+{
+    n = n.trimmed();
+    if (n.negative() || n.size() == 0 || (n.size() == 1 && n[0] < 2))
+    {
+        return false;
+    }
+    if (n[0] % 2 == 0)
+    {
+        return n.size() == 1 && n[0] == 2;
+    }
+
+    bigint value(n);
+    bool small = n.size() == 1;
+    for (size_t i = 0; i < bigint_trial_primes;)
+    {
+        // the largest group of primes whose product fits in a limb
+        uint64_t product = 1;
+        size_t end = i;
+        while (end < bigint_trial_primes && product <= UINT64_MAX / bigint_small_primes[end])
+        {
+            product *= bigint_small_primes[end++];
+        }
+        uint64_t remainder = bigint_view(value % product)[0];
+        for (; i < end; i++)
+        {
+            if (remainder % bigint_small_primes[i] == 0)
+            {
+                return small && n[0] == bigint_small_primes[i];
+            }
+        }
+    }
+    if (small && n[0] < 2000 * 2000)
+    {
+        return true;
+    }
+
+    bigint_montgomery mont(n);
+    bigint n_minus_one = value - 1;
+    size_t s = n_minus_one.countr_zero();
+    bigint d = n_minus_one >> s;
+    if (!bigint_miller_rabin(mont, mont.from_small(2), d, s) || !bigint_strong_lucas(mont, n))
+    {
+        return false;
+    }
+    for (size_t i = 0; i < rounds && i < bigint_trial_primes; i++)
+    {
+        if (!bigint_miller_rabin(mont, mont.from_small(bigint_small_primes[i]), d, s))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief find the smallest probable prime greater than a number
+ *
+ * The remainders of the candidate modulo the small primes are computed once and then
+ * updated as the candidate steps by 2, so only candidates without a small factor are
+ * passed to is_probable_prime.
+ *
+ * @param n a number
+ * @return bigint the smallest (probable) prime greater than n
+ */
+inline bigint next_prime(bigint_view n)
+{
+    if (n < bigint(2))
+    {
+        return bigint(2);
+    }
+    bigint candidate = bigint(n) + 1;
+    if (bigint_view(candidate)[0] % 2 == 0)
+    {
+        candidate += 1;
+    }
+    if (candidate.bit_length() <= 32) // below 2^32 a sieve hit may be the prime itself
+    {
+        while (!is_probable_prime(candidate))
+        {
+            candidate += 2;
+        }
+        return candidate;
+    }
+
+    std::vector<uint32_t> remainders(bigint_small_primes.size());
+    for (size_t i = 0; i < remainders.size(); i++)
+    {
+        remainders[i] = uint32_t(bigint_view(candidate % bigint_small_primes[i])[0]);
+    }
+    uint64_t offset = 0;
+    for (;;)
+    {
+        bool sieved = false;
+        for (size_t i = 0; i < remainders.size() && !sieved; i++)
+        {
+            sieved = (remainders[i] + offset) % bigint_small_primes[i] == 0;
+        }
+        if (!sieved && is_probable_prime(candidate + offset))
+        {
+            return candidate + offset;
+        }
+        offset += 2;
+    }
+}
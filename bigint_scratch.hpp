@@ -0,0 +1,208 @@
+/**
+ * @file bigint_scratch.hpp
+ * @author Shihong Cong
+ * @brief A per-thread stack of limbs for the temporaries of the recursive algorithms
+ * @version 0.1
+ * @date 2024-12-29
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * Karatsuba multiplication, recursive division, decimal conversion and GCD take their
+ * temporary limb arrays from the calling thread's arena instead of allocating a vector for
+ * each one. Space is taken through a bigint_scratch_frame and handed back when the frame goes
+ * out of scope, so the arena is used as a stack. The arena only grows, so once it has reached
+ * the size an operation needs, repeating that operation allocates nothing, and threads never
+ * contend on the heap for temporaries.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+#include "bigint_kernels.hpp"
+#include "bigint_stats.hpp"
+
+/**
+ * @brief one thread's stack of temporary limbs, held in a few blocks that are never moved
+ *
+ */
+class bigint_scratch
+{
+public:
+    static bigint_scratch &local(); // the calling thread's arena
+
+    size_t capacity() const;    // limbs held in all blocks
+    size_t block_count() const; // number of blocks, 1 once the arena has settled
+    size_t in_use() const;      // limbs taken by the frames still open
+
+    bigint_scratch(const bigint_scratch &) = delete;
+    bigint_scratch &operator=(const bigint_scratch &) = delete;
+
+private:
+    using limb_vector = std::vector<bigint_limb, bigint_allocator<bigint_limb>>;
+
+    static constexpr size_t min_block = 4096; // limbs in the first block
+
+    std::vector<limb_vector> blocks; // blocks in the order they are filled
+    size_t block = 0;                // the block being filled
+    size_t used = 0;                 // limbs taken from that block
+    size_t taken = 0;                // limbs taken from all blocks
+
+    bigint_scratch() = default;
+    bigint_limb *take(size_t); // n uninitialised limbs on top of the stack
+    void settle();             // merge the blocks into one while nothing is taken
+
+    friend class bigint_scratch_frame;
+};
+
+/**
+ * @brief a scope that takes limbs from the calling thread's arena and returns them at its end
+ *
+ * Frames must end in the reverse order they began, which holding them as local variables ensures.
+ */
+class bigint_scratch_frame
+{
+public:
+    bigint_scratch_frame();  // marks the top of the calling thread's arena
+    ~bigint_scratch_frame(); // returns everything taken since the mark
+
+    bigint_limb *take(size_t); // n uninitialised limbs, valid until the frame ends
+
+    bigint_scratch_frame(const bigint_scratch_frame &) = delete;
+    bigint_scratch_frame &operator=(const bigint_scratch_frame &) = delete;
+
+private:
+    bigint_scratch &scratch; // the arena of the thread that made the frame
+    size_t block;            // the block being filled when the frame began
+    size_t used;             // limbs taken from that block when the frame began
+    size_t taken;            // limbs taken from all blocks when the frame began
+};
+
+/**
+ * @brief the calling thread's arena
+ *
+ * @return bigint_scratch& an arena made on first use and freed when the thread exits
+ */
+inline bigint_scratch &bigint_scratch::local()
+{
+    static thread_local bigint_scratch scratch;
+    return scratch;
+}
+
+/**
+ * @brief the size of the arena
+ *
+ * @return size_t limbs held in all blocks, in use or not
+ */
+inline size_t bigint_scratch::capacity() const
+{
+    size_t total = 0;
+    for (const limb_vector &b : blocks)
+    {
+        total += b.size();
+    }
+    return total;
+}
+
+/**
+ * @brief the number of blocks the arena is split into
+ *
+ * @return size_t the number of blocks
+ */
+inline size_t bigint_scratch::block_count() const
+{
+    return blocks.size();
+}
+
+/**
+ * @brief the limbs taken by frames that have not ended
+ *
+ * @return size_t the number of limbs, 0 outside every frame
+ */
+inline size_t bigint_scratch::in_use() const
+{
+    return taken;
+}
+
+/**
+ * @brief take limbs from the top of the stack
+ *
+ * A request that does not fit in the rest of the current block moves on to the next block,
+ * replacing it with a larger one if it is too small, or adding a block at least as large as
+ * all the others together. Blocks after the current one hold nothing, so replacing them is safe.
+ *
+ * @param n the number of limbs
+ * @return bigint_limb* n uninitialised limbs
+ */
+inline bigint_limb *bigint_scratch::take(size_t n)
+{
+    if (blocks.empty())
+    {
+        blocks.emplace_back(std::max(n, min_block));
+    }
+    else if (blocks[block].size() - used < n)
+    {
+        block++;
+        used = 0;
+        if (block == blocks.size())
+        {
+            blocks.emplace_back(std::max(n, capacity()));
+        }
+        else if (blocks[block].size() < n)
+        {
+            blocks[block] = limb_vector(std::max(n, 2 * blocks[block].size()));
+        }
+    }
+    bigint_limb *limbs = blocks[block].data() + used;
+    used += n;
+    taken += n;
+    return limbs;
+}
+
+/**
+ * @brief replace several blocks with one as large as all of them, once nothing is taken
+ *
+ * After the first operation that needs more than one block the arena is a single block large
+ * enough for it, so the operation never spills across blocks again.
+ */
+inline void bigint_scratch::settle()
+{
+    if (taken == 0 && blocks.size() > 1)
+    {
+        size_t total = capacity();
+        blocks.clear();
+        blocks.emplace_back(total);
+    }
+}
+
+/**
+ * @brief Construct a new bigint_scratch_frame object at the top of the calling thread's arena
+ *
+ */
+inline bigint_scratch_frame::bigint_scratch_frame()
+    : scratch(bigint_scratch::local()), block(scratch.block), used(scratch.used), taken(scratch.taken)
+{
+}
+
+/**
+ * @brief Destroy the bigint_scratch_frame object, returning its limbs to the arena
+ *
+ */
+inline bigint_scratch_frame::~bigint_scratch_frame()
+{
+    scratch.block = block;
+    scratch.used = used;
+    scratch.taken = taken;
+    scratch.settle();
+}
+
+/**
+ * @brief take limbs for the rest of the frame
+ *
+ * @param n the number of limbs
+ * @return bigint_limb* n uninitialised limbs, valid until the frame ends
+ */
+inline bigint_limb *bigint_scratch_frame::take(size_t n)
+{
+    return scratch.take(n);
+}
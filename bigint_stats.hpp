@@ -0,0 +1,391 @@
+/**
+ * @file bigint_stats.hpp
+ * @author Shihong Cong
+ * @brief Opt-in instrumentation counters for bigint operations, allocations and algorithm selection
+ * @version 0.1
+ * @date 2024-12-29
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * The counters are compiled in only when BIGINT_INSTRUMENTATION is defined before the first
+ * #include "bigint.hpp". Otherwise every hook expands to nothing, bigint uses std::allocator,
+ * and bigint_stats_snapshot() returns all zeros.
+ */
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+
+/**
+ * @brief the operations counted by the instrumentation
+ *
+ */
+enum class bigint_op
+{
+    construct, // construction from int64_t or a view
+    parse,     // construction from a string
+    print,     // stream insertion
+    add,       // operator+ and operator+=
+    subtract,  // operator- and operator-=
+    multiply,  // operator*, operator*=, fma and fms
+    divide,    // operator/, operator%, and their assignments
+    power,     // pow
+    compare,   // ==, !=, <, <=, >, >=
+    increment, // operator++
+    decrement, // operator--
+    bitwise,   // &, |, ^ and ~
+    shift,     // << and >> by a number of bits
+    count      // number of operations
+};
+
+/**
+ * @brief the algorithms whose selection is counted by the instrumentation
+ *
+ */
+enum class bigint_algorithm
+{
+    mul_schoolbook,  // long multiplication
+    mul_single_limb, // multiplication by a native integer
+    sqr_schoolbook,  // long multiplication of a number by itself
+    addmul,          // fma and fms, row by row into the accumulator
+    div_single_limb, // division by a native integer
+    mul_karatsuba,   // Karatsuba multiplication
+    div_schoolbook,  // long division by a multi-limb divisor
+    div_recursive,   // Burnikel-Ziegler recursive division
+    sqr_karatsuba,   // Karatsuba squaring
+    dec_recursive,   // divide-and-conquer decimal parsing and printing
+    count            // number of algorithms
+};
+
+/**
+ * @brief a snapshot of the instrumentation counters
+ *
+ */
+struct bigint_stats
+{
+    static constexpr size_t op_count = size_t(bigint_op::count);
+    static constexpr size_t algorithm_count = size_t(bigint_algorithm::count);
+    static constexpr size_t size_buckets = 65; // bucket k counts operands of [2^(k-1), 2^k) limbs
+
+    /**
+     * @brief the counters of one operation
+     *
+     */
+    struct operation
+    {
+        uint64_t calls = 0;       // number of calls
+        uint64_t nanoseconds = 0; // time spent, including nested operations
+    };
+
+    std::array<operation, op_count> operations{};                                  // indexed by bigint_op
+    uint64_t allocations = 0;                                                     // limb buffer allocations
+    uint64_t deallocations = 0;                                                   // limb buffer deallocations
+    uint64_t bytes_allocated = 0;                                                 // total size of the allocations
+    std::array<std::array<uint64_t, size_buckets>, algorithm_count> algorithms{}; // selections by algorithm and size bucket
+
+    const operation &operator[](bigint_op op) const; // counters of one operation
+    uint64_t selections(bigint_algorithm) const;     // selections of an algorithm at any size
+};
+
+bigint_stats bigint_stats_snapshot(); // read the counters
+void bigint_stats_reset();            // set every counter to zero
+const char *to_string(bigint_op);
+const char *to_string(bigint_algorithm);
+std::ostream &operator<<(std::ostream &, const bigint_stats &); // print a report
+
+/**
+ * @brief the live counters, updated with relaxed atomics so that every thread can count
+ *
+ */
+struct bigint_counters
+{
+    std::array<std::atomic<uint64_t>, bigint_stats::op_count> calls{};
+    std::array<std::atomic<uint64_t>, bigint_stats::op_count> nanoseconds{};
+    std::atomic<uint64_t> allocations{0};
+    std::atomic<uint64_t> deallocations{0};
+    std::atomic<uint64_t> bytes_allocated{0};
+    std::array<std::array<std::atomic<uint64_t>, bigint_stats::size_buckets>, bigint_stats::algorithm_count> algorithms{};
+
+    static bigint_counters &get(); // the process-wide counters
+};
+
+/**
+ * @brief counts one call of an operation and the time until the end of the enclosing scope
+ *
+ */
+class bigint_op_timer
+{
+public:
+    explicit bigint_op_timer(bigint_op);
+    ~bigint_op_timer();
+    bigint_op_timer(const bigint_op_timer &) = delete;
+    bigint_op_timer &operator=(const bigint_op_timer &) = delete;
+
+private:
+    bigint_op op;
+    std::chrono::steady_clock::time_point start;
+};
+
+/**
+ * @brief an allocator that counts the allocations of bigint limb buffers
+ *
+ * @tparam T the element type
+ */
+template <typename T>
+struct bigint_counting_allocator : std::allocator<T>
+{
+    using value_type = T;
+
+    bigint_counting_allocator() = default;
+    template <typename U>
+    bigint_counting_allocator(const bigint_counting_allocator<U> &) {}
+
+    T *allocate(size_t);
+    void deallocate(T *, size_t);
+
+    template <typename U>
+    struct rebind
+    {
+        using other = bigint_counting_allocator<U>;
+    };
+};
+
+#ifdef BIGINT_INSTRUMENTATION
+#define BIGINT_COUNT_OP(op) bigint_op_timer bigint_op_timer_scope(op)
+#define BIGINT_COUNT_ALGORITHM(algorithm, size) bigint_count_algorithm(algorithm, size)
+template <typename T>
+using bigint_allocator = bigint_counting_allocator<T>;
+#else
+#define BIGINT_COUNT_OP(op) ((void)0)
+#define BIGINT_COUNT_ALGORITHM(algorithm, size) ((void)0)
+template <typename T>
+using bigint_allocator = std::allocator<T>;
+#endif
+
+/**
+ * @brief the process-wide counters
+ *
+ * @return bigint_counters& the counters
+ */
+inline bigint_counters &bigint_counters::get()
+{
+    static bigint_counters counters;
+    return counters;
+}
+
+/**
+ * @brief Construct a new bigint_op_timer object and count one call
+ *
+ * @param counted the operation being called
+ */
+inline bigint_op_timer::bigint_op_timer(bigint_op counted) : op(counted), start(std::chrono::steady_clock::now())
+{
+    bigint_counters::get().calls[size_t(op)].fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Destroy the bigint_op_timer object and add the elapsed time
+ *
+ */
+inline bigint_op_timer::~bigint_op_timer()
+{
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+    bigint_counters::get().nanoseconds[size_t(op)].fetch_add(uint64_t(elapsed.count()), std::memory_order_relaxed);
+}
+
+/**
+ * @brief count that an algorithm was chosen
+ *
+ * @param algorithm the chosen algorithm
+ * @param size the size of the larger operand in limbs
+ */
+inline void bigint_count_algorithm(bigint_algorithm algorithm, size_t size)
+{
+    bigint_counters::get().algorithms[size_t(algorithm)][size_t(std::bit_width(size))].fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ * @brief allocate and count a limb buffer
+ *
+ * @param n the number of elements
+ * @return T* the buffer
+ */
+template <typename T>
+T *bigint_counting_allocator<T>::allocate(size_t n)
+{
+    bigint_counters &counters = bigint_counters::get();
+    counters.allocations.fetch_add(1, std::memory_order_relaxed);
+    counters.bytes_allocated.fetch_add(n * sizeof(T), std::memory_order_relaxed);
+    return std::allocator<T>::allocate(n);
+}
+
+/**
+ * @brief deallocate and count a limb buffer
+ *
+ * @param p the buffer
+ * @param n the number of elements
+ */
+template <typename T>
+void bigint_counting_allocator<T>::deallocate(T *p, size_t n)
+{
+    bigint_counters::get().deallocations.fetch_add(1, std::memory_order_relaxed);
+    std::allocator<T>::deallocate(p, n);
+}
+
+/**
+ * @brief Overload the == operator, all counting allocators are interchangeable
+ *
+ * @return true always
+ */
+template <typename T, typename U>
+bool operator==(const bigint_counting_allocator<T> &, const bigint_counting_allocator<U> &)
+{
+    return true;
+}
+
+/**
+ * @brief the counters of one operation
+ *
+ * @param op the operation
+ * @return const bigint_stats::operation& its calls and time
+ */
+inline const bigint_stats::operation &bigint_stats::operator[](bigint_op op) const
+{
+    return operations[size_t(op)];
+}
+
+/**
+ * @brief the selections of an algorithm summed over every size
+ *
+ * @param algorithm the algorithm
+ * @return uint64_t the number of times it was chosen
+ */
+inline uint64_t bigint_stats::selections(bigint_algorithm algorithm) const
+{
+    uint64_t total = 0;
+    for (uint64_t count : algorithms[size_t(algorithm)])
+    {
+        total += count;
+    }
+    return total;
+}
+
+/**
+ * @brief read the counters, all zero unless BIGINT_INSTRUMENTATION is defined
+ *
+ * @return bigint_stats a copy of the counters
+ */
+inline bigint_stats bigint_stats_snapshot()
+{
+    bigint_stats stats;
+    const bigint_counters &counters = bigint_counters::get();
+    for (size_t i = 0; i < bigint_stats::op_count; i++)
+    {
+        stats.operations[i].calls = counters.calls[i].load(std::memory_order_relaxed);
+        stats.operations[i].nanoseconds = counters.nanoseconds[i].load(std::memory_order_relaxed);
+    }
+    stats.allocations = counters.allocations.load(std::memory_order_relaxed);
+    stats.deallocations = counters.deallocations.load(std::memory_order_relaxed);
+    stats.bytes_allocated = counters.bytes_allocated.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < bigint_stats::algorithm_count; i++)
+    {
+        for (size_t j = 0; j < bigint_stats::size_buckets; j++)
+        {
+            stats.algorithms[i][j] = counters.algorithms[i][j].load(std::memory_order_relaxed);
+        }
+    }
+    return stats;
+}
+
+/**
+ * @brief set every counter to zero
+ *
+ */
+inline void bigint_stats_reset()
+{
+    bigint_counters &counters = bigint_counters::get();
+    for (size_t i = 0; i < bigint_stats::op_count; i++)
+    {
+        counters.calls[i].store(0, std::memory_order_relaxed);
+        counters.nanoseconds[i].store(0, std::memory_order_relaxed);
+    }
+    counters.allocations.store(0, std::memory_order_relaxed);
+    counters.deallocations.store(0, std::memory_order_relaxed);
+    counters.bytes_allocated.store(0, std::memory_order_relaxed);
+    for (auto &sizes : counters.algorithms)
+    {
+        for (auto &count : sizes)
+        {
+            count.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+/**
+ * @brief the name of an operation
+ *
+ * @param op the operation
+ * @return const char* its name
+ */
+inline const char *to_string(bigint_op op)
+{
+    static constexpr const char *names[] = {"construct", "parse", "print", "add", "subtract",
+                                            "multiply", "divide", "power", "compare", "increment", "decrement",
+                                            "bitwise", "shift"};
+    return names[size_t(op)];
+}
+
+/**
+ * @brief the name of an algorithm
+ *
+ * @param algorithm the algorithm
+ * @return const char* its name
+ */
+inline const char *to_string(bigint_algorithm algorithm)
+{
+    static constexpr const char *names[] = {"mul_schoolbook", "mul_single_limb", "sqr_schoolbook", "addmul", "div_single_limb",
+                                                  "mul_karatsuba", "div_schoolbook", "div_recursive", "sqr_karatsuba",
+                                                  "dec_recursive"};
+    return names[size_t(algorithm)];
+}
+
+/**
+ * @brief Overload the << operator to print a report of a snapshot
+ *
+ * @param os an output stream
+ * @param stats a snapshot
+ * @return std::ostream& the output stream
+ */
+inline std::ostream &operator<<(std::ostream &os, const bigint_stats &stats)
+{
+    os << std::left << std::setw(12) << "operation" << std::right << std::setw(14) << "calls" << std::setw(16) << "ns" << '\n';
+    for (size_t i = 0; i < bigint_stats::op_count; i++)
+    {
+        if (stats.operations[i].calls > 0)
+        {
+            os << std::left << std::setw(12) << to_string(bigint_op(i)) << std::right << std::setw(14) << stats.operations[i].calls
+               << std::setw(16) << stats.operations[i].nanoseconds << '\n';
+        }
+    }
+    os << "allocations: " << stats.allocations << ", deallocations: " << stats.deallocations
+       << ", bytes allocated: " << stats.bytes_allocated << '\n';
+    for (size_t i = 0; i < bigint_stats::algorithm_count; i++)
+    {
+        for (size_t j = 0; j < bigint_stats::size_buckets; j++)
+        {
+            if (stats.algorithms[i][j] > 0)
+            {
+                size_t low = j == 0 ? 0 : size_t(1) << (j - 1);
+                os << to_string(bigint_algorithm(i)) << " at " << low << ".." << (j == 0 ? 0 : 2 * low - 1)
+                   << " limbs: " << stats.algorithms[i][j] << '\n';
+            }
+        }
+    }
+    return os;
+}
@@ -0,0 +1,194 @@
+/**
+ * @file bigint_thresholds.hpp
+ * @author Shihong Cong
+ * @brief The operand sizes at which multiplication, division and conversion switch algorithms
+ * @version 0.1
+ * @date 2024-12-29
+ *
+ * @copyright Copyright (c) 2024
+ *
+ * The defaults come from bigint_tuned.hpp when the tune tool has generated one next to this
+ * header, and from the BIGINT_*_THRESHOLD macros otherwise, which -D flags can also set. At
+ * startup a file named by the BIGINT_THRESHOLDS environment variable, in the format written by
+ * tune --config, replaces them, so one binary can be tuned for each host it runs on.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#if __has_include("bigint_tuned.hpp")
+#include "bigint_tuned.hpp"
+#endif
+
+#ifndef BIGINT_KARATSUBA_THRESHOLD
+#define BIGINT_KARATSUBA_THRESHOLD 48
+#endif
+#ifndef BIGINT_KARATSUBA_SQUARE_THRESHOLD
+#define BIGINT_KARATSUBA_SQUARE_THRESHOLD 96
+#endif
+#ifndef BIGINT_RECURSIVE_DIVISION_THRESHOLD
+#define BIGINT_RECURSIVE_DIVISION_THRESHOLD 128
+#endif
+#ifndef BIGINT_RECURSIVE_CONVERSION_THRESHOLD
+#define BIGINT_RECURSIVE_CONVERSION_THRESHOLD 80
+#endif
+
+/**
+ * @brief the algorithm crossover points, each a number of limbs
+ *
+ */
+struct bigint_thresholds
+{
+    size_t karatsuba = BIGINT_KARATSUBA_THRESHOLD;                     // limbs of the shorter factor from which multiplication uses Karatsuba
+    size_t karatsuba_square = BIGINT_KARATSUBA_SQUARE_THRESHOLD;       // limbs from which squaring uses Karatsuba
+    size_t recursive_division = BIGINT_RECURSIVE_DIVISION_THRESHOLD;   // limbs of the divisor from which division is recursive
+    size_t recursive_conversion = BIGINT_RECURSIVE_CONVERSION_THRESHOLD; // limbs from which decimal conversion divides and conquers
+
+    static constexpr size_t minimum = 4; // the smallest threshold the recursive algorithms accept, smaller values are raised to it
+
+    static bigint_thresholds load(std::istream &); // read "name value" lines, throws on a bad line
+    void save(std::ostream &) const;               // write "name value" lines
+    void save_header(std::ostream &) const;        // write a bigint_tuned.hpp that makes these the defaults
+    static bigint_thresholds startup();            // the file named by BIGINT_THRESHOLDS, or the defaults
+
+    bool operator==(const bigint_thresholds &) const = default;
+};
+
+static_assert(BIGINT_KARATSUBA_THRESHOLD >= bigint_thresholds::minimum, "BIGINT_KARATSUBA_THRESHOLD is below the minimum of 4");
+static_assert(BIGINT_KARATSUBA_SQUARE_THRESHOLD >= bigint_thresholds::minimum, "BIGINT_KARATSUBA_SQUARE_THRESHOLD is below the minimum of 4");
+static_assert(BIGINT_RECURSIVE_DIVISION_THRESHOLD >= bigint_thresholds::minimum, "BIGINT_RECURSIVE_DIVISION_THRESHOLD is below the minimum of 4");
+static_assert(BIGINT_RECURSIVE_CONVERSION_THRESHOLD >= bigint_thresholds::minimum, "BIGINT_RECURSIVE_CONVERSION_THRESHOLD is below the minimum of 4");
+
+/**
+ * @brief read thresholds from lines of a name and a number of limbs
+ *
+ * Blank lines and lines starting with '#' are skipped, and thresholds not named keep their defaults.
+ *
+ * @param in a stream in the format written by save
+ * @return bigint_thresholds the thresholds read
+ */
+inline bigint_thresholds bigint_thresholds::load(std::istream &in)
+{
+    bigint_thresholds thresholds;
+    std::string line;
+    while (std::getline(in, line))
+    {
+        std::istringstream fields(line);
+        std::string name;
+        if (!(fields >> name) || name[0] == '#')
+        {
+            continue;
+        }
+        long long value;
+        std::string rest;
+        if (!(fields >> value) || fields >> rest || value < static_cast<long long>(minimum))
+        {
+            throw std::invalid_argument("Invalid threshold line: " + line);
+        }
+        if (name == "karatsuba")
+        {
+            thresholds.karatsuba = size_t(value);
+        }
+        else if (name == "karatsuba_square")
+        {
+            thresholds.karatsuba_square = size_t(value);
+        }
+        else if (name == "recursive_division")
+        {
+            thresholds.recursive_division = size_t(value);
+        }
+        else if (name == "recursive_conversion")
+        {
+            thresholds.recursive_conversion = size_t(value);
+        }
+        else
+        {
+            throw std::invalid_argument("Unknown threshold: " + name);
+        }
+    }
+    return thresholds;
+}
+
+/**
+ * @brief write the thresholds in the format read by load
+ *
+ * @param out an output stream
+ */
+inline void bigint_thresholds::save(std::ostream &out) const
+{
+    out << "karatsuba " << karatsuba << '\n'
+        << "karatsuba_square " << karatsuba_square << '\n'
+        << "recursive_division " << recursive_division << '\n'
+        << "recursive_conversion " << recursive_conversion << '\n';
+}
+
+/**
+ * @brief write a header that makes the thresholds the compiled-in defaults
+ *
+ * @param out an output stream, saved as bigint_tuned.hpp next to bigint_thresholds.hpp
+ */
+inline void bigint_thresholds::save_header(std::ostream &out) const
+{
+    out << "// generated by tune for this machine, delete it to return to the built-in defaults\n"
+        << "#pragma once\n\n"
+        << "#define BIGINT_KARATSUBA_THRESHOLD " << karatsuba << '\n'
+        << "#define BIGINT_KARATSUBA_SQUARE_THRESHOLD " << karatsuba_square << '\n'
+        << "#define BIGINT_RECURSIVE_DIVISION_THRESHOLD " << recursive_division << '\n'
+        << "#define BIGINT_RECURSIVE_CONVERSION_THRESHOLD " << recursive_conversion << '\n';
+}
+
+/**
+ * @brief the thresholds to start with
+ *
+ * A file that cannot be read or parsed is reported on std::cerr and the defaults are used,
+ * since this runs before main where an exception could not be caught.
+ *
+ * @return bigint_thresholds the thresholds in the file named by BIGINT_THRESHOLDS if it is set, the defaults otherwise
+ */
+inline bigint_thresholds bigint_thresholds::startup()
+{
+    const char *path = std::getenv("BIGINT_THRESHOLDS");
+    if (path == nullptr || *path == '\0')
+    {
+        return bigint_thresholds();
+    }
+    std::ifstream file(path);
+    try
+    {
+        if (!file)
+        {
+            throw std::invalid_argument(std::string("Cannot open ") + path);
+        }
+        return load(file);
+    }
+    catch (const std::invalid_argument &e)
+    {
+        std::cerr << "BIGINT_THRESHOLDS ignored: " << e.what() << std::endl;
+        return bigint_thresholds();
+    }
+}
+
+// the thresholds in use, read once before main; assign new ones before other threads start using bigint
+inline bigint_thresholds bigint_active_thresholds = bigint_thresholds::startup();
+
+/**
+ * @brief a threshold in use, as the algorithms read it
+ *
+ * Values assigned to bigint_active_thresholds directly are not checked, so they are raised to
+ * bigint_thresholds::minimum here; a smaller one would make the recursive algorithms split
+ * operands too short to split.
+ *
+ * @param threshold the threshold in bigint_active_thresholds to read
+ * @return size_t the threshold, at least bigint_thresholds::minimum
+ */
+inline size_t bigint_threshold(size_t bigint_thresholds::*threshold)
+{
+    return std::max(bigint_active_thresholds.*threshold, bigint_thresholds::minimum);
+}
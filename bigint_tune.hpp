@@ -0,0 +1,198 @@
+/**
+ * @file bigint_tune.hpp
+ * @author Shihong Cong
+ * @brief Measures the algorithm crossover points of bigint on the running machine
+ * @version 0.1
+ * @date 2024-12-29
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "bigint.hpp"
+
+/**
+ * @brief the options of a tuning run
+ *
+ */
+struct bigint_tune_options
+{
+    double min_time = 0.05;      // seconds spent timing each algorithm at each size
+    size_t max_limbs = 1024;     // largest operand size tried; a crossover above it means never switching
+    std::ostream *log = nullptr; // where to report each size measured, nowhere if null
+};
+
+bigint_thresholds bigint_tune(const bigint_tune_options & = bigint_tune_options()); // measure every threshold, in dependency order
+
+/**
+ * @brief time an operation, taking the fastest of a few batches to filter out interruptions
+ *
+ * @param run the operation
+ * @param min_time seconds to spend in total
+ * @return double nanoseconds per call
+ */
+inline double bigint_tune_time(const std::function<void()> &run, double min_time)
+{
+    using clock = std::chrono::steady_clock;
+    double best = 0;
+    for (int batch = 0; batch < 3; batch++)
+    {
+        uint64_t iterations = 0;
+        clock::time_point start = clock::now();
+        double elapsed = 0;
+        do
+        {
+            run();
+            iterations++;
+            elapsed = std::chrono::duration<double>(clock::now() - start).count();
+        } while (elapsed < min_time / 3);
+        double ns = elapsed * 1e9 / double(iterations);
+        best = batch == 0 ? ns : std::min(best, ns);
+    }
+    return best;
+}
+
+/**
+ * @brief find the size from which the recursive algorithm beats the basecase
+ *
+ * At each size the operation is timed with the threshold just above the size, so that only the
+ * basecase runs, and at the size, so that the top level recurses once onto the basecase. The
+ * crossover is the first size from which the recursive version wins twice in a row, so one
+ * noisy measurement does not end the search.
+ *
+ * @param name the threshold's name, for the log
+ * @param threshold the threshold in bigint_active_thresholds to vary
+ * @param operation makes the operation to time for operands of a number of limbs
+ * @param options the tuning options
+ * @return size_t the crossover, max_limbs + 1 if the basecase always wins
+ */
+inline size_t bigint_tune_crossover(const std::string &name, size_t bigint_thresholds::*threshold,
+                                    const std::function<std::function<void()>(size_t)> &operation,
+                                    const bigint_tune_options &options)
+{
+    size_t saved = bigint_active_thresholds.*threshold;
+    size_t found = options.max_limbs + 1;
+    size_t first_win = 0;
+    for (size_t n = 2 * bigint_thresholds::minimum; n <= options.max_limbs; n = std::max(n + 1, n * 9 / 8))
+    {
+        std::function<void()> run = operation(n);
+        bigint_active_thresholds.*threshold = n + 1;
+        double basecase = bigint_tune_time(run, options.min_time);
+        bigint_active_thresholds.*threshold = n;
+        double recursive = bigint_tune_time(run, options.min_time);
+        if (options.log != nullptr)
+        {
+            *options.log << std::left << std::setw(22) << name << std::right << std::setw(8) << n << std::fixed
+                         << std::setprecision(0) << std::setw(14) << basecase << std::setw(14) << recursive << std::endl;
+        }
+
+        if (recursive >= basecase)
+        {
+            first_win = 0;
+        }
+        else if (first_win == 0)
+        {
+            first_win = n;
+        }
+        else
+        {
+            found = first_win;
+            break;
+        }
+    }
+    bigint_active_thresholds.*threshold = saved;
+    return found;
+}
+
+/**
+ * @brief a random non-negative number of exactly n limbs
+ *
+ * @param n the number of limbs
+ * @param mt64 the random number generator
+ * @return bigint a number whose top limb is not zero
+ */
+inline bigint bigint_tune_operand(size_t n, std::mt19937_64 &mt64)
+{
+    std::vector<bigint_limb> limbs(n);
+    for (bigint_limb &limb : limbs)
+    {
+        limb = mt64();
+    }
+    limbs.back() |= bigint_limb(1) << (bigint_limb_bits - 1);
+    return bigint(bigint_view(limbs));
+}
+
+/**
+ * @brief measure every threshold on the running machine
+ *
+ * Multiplication is tuned first, since squaring, division and conversion all multiply, then
+ * division, which conversion uses, and conversion last, each with the thresholds already found
+ * active. bigint_active_thresholds is left unchanged; assign the result to it to use it.
+ *
+ * @param options the tuning options
+ * @return bigint_thresholds the measured crossover points
+ */
+inline bigint_thresholds bigint_tune(const bigint_tune_options &options)
+{
+    bigint_thresholds saved = bigint_active_thresholds;
+    std::mt19937_64 mt64(43);
+    if (options.log != nullptr)
+    {
+        *options.log << std::left << std::setw(22) << "threshold" << std::right << std::setw(8) << "limbs"
+                     << std::setw(14) << "basecase ns" << std::setw(14) << "recursive ns" << std::endl;
+    }
+
+    bigint_active_thresholds.karatsuba = bigint_tune_crossover(
+        "karatsuba", &bigint_thresholds::karatsuba,
+        [&](size_t n) -> std::function<void()>
+        {
+            return [a = bigint_tune_operand(n, mt64), b = bigint_tune_operand(n, mt64)] { (void)(a * b); };
+        },
+        options);
+
+    bigint_active_thresholds.karatsuba_square = bigint_tune_crossover(
+        "karatsuba_square", &bigint_thresholds::karatsuba_square,
+        [&](size_t n) -> std::function<void()>
+        {
+            return [a = bigint_tune_operand(n, mt64)] { (void)(a * a); };
+        },
+        options);
+
+    bigint_active_thresholds.recursive_division = bigint_tune_crossover(
+        "recursive_division", &bigint_thresholds::recursive_division,
+        [&](size_t n) -> std::function<void()>
+        {
+            bigint b = bigint_tune_operand(n, mt64);
+            return [a = bigint_tune_operand(2 * n, mt64), b] { (void)divmod(a, b); };
+        },
+        options);
+
+    bigint_active_thresholds.recursive_conversion = bigint_tune_crossover(
+        "recursive_conversion", &bigint_thresholds::recursive_conversion,
+        [&](size_t n) -> std::function<void()>
+        {
+            std::ostringstream digits;
+            digits << bigint_tune_operand(n, mt64);
+            return [a = bigint_tune_operand(n, mt64), str = digits.str()]
+            {
+                std::ostringstream out;
+                out << a;
+                (void)bigint(str);
+            };
+        },
+        options);
+
+    bigint_thresholds tuned = bigint_active_thresholds;
+    bigint_active_thresholds = saved;
+    return tuned;
+}
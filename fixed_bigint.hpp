@@ -0,0 +1,719 @@
+/**
+ * @file fixed_bigint.hpp
+ * @author Shihong Cong
+ * @brief A fixed-width integer class template with constexpr arithmetic and no heap allocation
+ * @version 0.1
+ * @date 2024-12-29
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#pragma once
+
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "bigint.hpp"
+
+/**
+ * @brief A signed Bits-bit integer stored in two's complement, for values with a known maximum width
+ *
+ * The value lives in an array of 64-bit limbs inside the object, so it never allocates.
+ * Every operation is constexpr and every loop over the limbs is unrolled at compile time.
+ * Arithmetic wraps modulo 2^Bits like the built-in integer types; conversions from strings
+ * and bigints check the range instead.
+ *
+ * @tparam Bits the width in bits, a positive multiple of 64 (e.g. 128, 256, 512, 1024)
+ */
+template <size_t Bits>
+class fixed_bigint
+{
+    static_assert(Bits > 0 && Bits % 64 == 0, "fixed_bigint width must be a positive multiple of 64 bits");
+
+public:
+    static constexpr size_t limb_count = Bits / bigint_limb_bits; // number of 64-bit limbs
+
+    // Constructors
+    constexpr fixed_bigint();                          // default constructor
+    constexpr fixed_bigint(int64_t);                   // constructor for processing int64_t
+    constexpr explicit fixed_bigint(std::string_view); // constructor for processing string
+    explicit fixed_bigint(bigint_view);                // constructor for converting a bigint
+
+    // conversion
+    bigint to_bigint() const; // convert to a bigint
+
+    // Operators
+    // subtraction
+    constexpr fixed_bigint operator-(const fixed_bigint &) const; // subtraction
+    constexpr fixed_bigint operator-=(const fixed_bigint &);      // subtraction assignment
+    // addition
+    constexpr fixed_bigint operator+(const fixed_bigint &) const; // addition
+    constexpr fixed_bigint operator+=(const fixed_bigint &);      // addition assignment
+
+    // multiplication
+    constexpr fixed_bigint operator*(const fixed_bigint &) const; // multiplication
+    constexpr fixed_bigint operator*=(const fixed_bigint &);      // multiplication assignment
+
+    // negation
+    constexpr fixed_bigint operator-() const; // unary negation
+
+    // comparison
+    constexpr bool operator==(const fixed_bigint &) const; // equal to
+    constexpr bool operator!=(const fixed_bigint &) const; // not equal to
+    constexpr bool operator<(const fixed_bigint &) const;  // less than
+    constexpr bool operator<=(const fixed_bigint &) const; // less than or equal to
+    constexpr bool operator>(const fixed_bigint &) const;  // greater than
+    constexpr bool operator>=(const fixed_bigint &) const; // greater than or equal to
+
+    // insertion
+    template <size_t B>
+    friend std::ostream &operator<<(std::ostream &, const fixed_bigint<B> &); // output stream
+
+    // increment and decrement
+    // pre + post
+    constexpr fixed_bigint operator++(); // pre-increment
+    constexpr fixed_bigint operator--(); // pre-decrement
+
+    constexpr fixed_bigint operator++(int); // post-increment
+    constexpr fixed_bigint operator--(int); // post-decrement
+
+    constexpr bool is_negative() const; // true if the sign bit is set
+
+private:
+    bigint_limb limbs[limb_count]; // little endian, two's complement
+
+    // helper functions, each unrolled over the limbs with a fold expression
+    static constexpr uint64_t add_limb(uint64_t, uint64_t, uint64_t &);              // limb sum with carry in and out
+    static constexpr uint64_t sub_limb(uint64_t, uint64_t, uint64_t &);              // limb difference with borrow in and out
+    static constexpr uint64_t mul_add_limb(uint64_t, uint64_t, uint64_t, uint64_t &); // a * b + c + carry
+    static constexpr int compare_limb(int, uint64_t, uint64_t);                       // order of two limbs unless already decided
+
+    template <size_t... I>
+    static constexpr fixed_bigint add(const fixed_bigint &, const fixed_bigint &, std::index_sequence<I...>);
+    template <size_t... I>
+    static constexpr fixed_bigint subtract(const fixed_bigint &, const fixed_bigint &, std::index_sequence<I...>);
+    template <size_t I, size_t... J>
+    static constexpr void multiply_row(fixed_bigint &, const fixed_bigint &, const fixed_bigint &, std::index_sequence<J...>);
+    template <size_t... I>
+    static constexpr fixed_bigint multiply(const fixed_bigint &, const fixed_bigint &, std::index_sequence<I...>);
+    template <size_t... I>
+    static constexpr bool is_equal(const fixed_bigint &, const fixed_bigint &, std::index_sequence<I...>);
+    template <size_t... I>
+    static constexpr int compare_unsigned(const fixed_bigint &, const fixed_bigint &, std::index_sequence<I...>);
+    template <size_t... I>
+    constexpr uint64_t multiply_add_small(uint64_t, uint64_t, std::index_sequence<I...>); // *this = *this * m + a, returns carry
+    template <size_t... I>
+    constexpr uint64_t divide_small(uint64_t, std::index_sequence<I...>);                 // *this /= d, returns remainder
+
+    constexpr void push_digit(uint64_t);  // append a decimal digit to an unsigned magnitude
+    constexpr void apply_sign(bool);      // turn an unsigned magnitude into a signed value
+    std::vector<int8_t> decimal() const;  // little endian decimal digits of the magnitude
+};
+
+/**
+ * @brief Construct a new fixed_bigint object with value 0
+ *
+ */
+template <size_t Bits>
+constexpr fixed_bigint<Bits>::fixed_bigint() : limbs{} {}
+
+/**
+ * @brief Construct a new fixed_bigint object
+ *
+ * @param val a int64_t value, sign extended to Bits bits
+ */
+template <size_t Bits>
+constexpr fixed_bigint<Bits>::fixed_bigint(int64_t val) : limbs{}
+{
+    limbs[0] = uint64_t(val);
+    for (size_t i = 1; i < limb_count; i++)
+    {
+        limbs[i] = val < 0 ? ~uint64_t(0) : 0;
+    }
+}
+
+/**
+ * @brief Construct a new fixed_bigint object, in a constant expression invalid input fails to compile
+ *
+ * @param str a string of decimal digits with an optional leading '-'
+ */
+template <size_t Bits>
+constexpr fixed_bigint<Bits>::fixed_bigint(std::string_view str) : limbs{}
+{
+    if (str.empty())
+    {
+        throw std::invalid_argument("Input String is Empty");
+    }
+
+    bool negative = (str[0] == '-');
+    size_t first = negative ? 1 : 0;
+    if (first == str.size())
+    {
+        throw std::invalid_argument("Invalid argument: " + std::string(str));
+    }
+
+    for (size_t i = first; i < str.size(); i++)
+    {
+        if (str[i] < '0' || str[i] > '9')
+        {
+            throw std::invalid_argument("Invalid argument: " + std::string(str));
+        }
+        push_digit(uint64_t(str[i] - '0'));
+    }
+    apply_sign(negative);
+}
+
+/**
+ * @brief Construct a new fixed_bigint object from a bigint or a view, copying its limbs
+ *
+ * @param num a bigint_view whose value must fit in Bits bits
+ */
+template <size_t Bits>
+fixed_bigint<Bits>::fixed_bigint(bigint_view num) : limbs{}
+{
+    num = num.trimmed();
+    if (num.size() > limb_count)
+    {
+        throw std::overflow_error("Value does not fit in fixed_bigint");
+    }
+    std::copy(num.limbs().begin(), num.limbs().end(), limbs);
+    apply_sign(num.negative());
+}
+
+/**
+ * @brief convert to a bigint, copying the limbs of the absolute value
+ *
+ * @return bigint a bigint with the same value
+ */
+template <size_t Bits>
+bigint fixed_bigint<Bits>::to_bigint() const
+{
+    fixed_bigint magnitude = is_negative() ? -*this : *this; // -2^(Bits-1) wraps to itself, which is its unsigned magnitude
+    return bigint(bigint_view(magnitude.limbs, is_negative()));
+}
+
+/**
+ * @brief a helper function to add two limbs and a carry
+ *
+ * @param a a limb
+ * @param b a limb
+ * @param carry the carry in (0 or 1), replaced by the carry out
+ * @return uint64_t the low 64 bits of the sum
+ */
+template <size_t Bits>
+constexpr uint64_t fixed_bigint<Bits>::add_limb(uint64_t a, uint64_t b, uint64_t &carry)
+{
+    uint64_t sum = a + carry;
+    uint64_t carry_out = (sum < carry);
+    sum += b;
+    carry = carry_out + (sum < b);
+    return sum;
+}
+
+/**
+ * @brief a helper function to subtract a limb and a borrow from a limb
+ *
+ * @param a a limb
+ * @param b a limb to be subtracted
+ * @param borrow the borrow in (0 or 1), replaced by the borrow out
+ * @return uint64_t the low 64 bits of the difference
+ */
+template <size_t Bits>
+constexpr uint64_t fixed_bigint<Bits>::sub_limb(uint64_t a, uint64_t b, uint64_t &borrow)
+{
+    uint64_t diff = a - borrow;
+    uint64_t borrow_out = (a < borrow);
+    borrow = borrow_out + (diff < b);
+    return diff - b;
+}
+
+/**
+ * @brief a helper function to compute a * b + c + carry, which always fits in two limbs
+ *
+ * @param a a limb
+ * @param b a limb
+ * @param c a limb
+ * @param carry the carry in, replaced by the high limb of the result
+ * @return uint64_t the low limb of the result
+ */
+template <size_t Bits>
+constexpr uint64_t fixed_bigint<Bits>::mul_add_limb(uint64_t a, uint64_t b, uint64_t c, uint64_t &carry)
+{
+    bigint_double_limb t = bigint_double_limb(a) * b + c + carry;
+    carry = uint64_t(t >> bigint_limb_bits);
+    return uint64_t(t);
+}
+
+/**
+ * @brief a helper function to compare two limbs, used from the most significant limb down
+ *
+ * @param order the order decided by the more significant limbs, 0 if they are equal
+ * @param a a limb
+ * @param b a limb
+ * @return int order if it is not 0, otherwise -1, 0 or 1 for a < b, a == b, a > b
+ */
+template <size_t Bits>
+constexpr int fixed_bigint<Bits>::compare_limb(int order, uint64_t a, uint64_t b)
+{
+    return order != 0 ? order : (a > b) - (a < b);
+}
+
+/**
+ * @brief a helper function contains the logic for addition, unrolled over the limbs
+ *
+ * @param num1 a fixed_bigint
+ * @param num2 a fixed_bigint
+ * @return fixed_bigint the sum modulo 2^Bits
+ */
+template <size_t Bits>
+template <size_t... I>
+constexpr fixed_bigint<Bits> fixed_bigint<Bits>::add(const fixed_bigint &num1, const fixed_bigint &num2, std::index_sequence<I...>)
+{
+    fixed_bigint result;
+    uint64_t carry = 0;
+    ((result.limbs[I] = add_limb(num1.limbs[I], num2.limbs[I], carry)), ...);
+    return result;
+}
+
+/**
+ * @brief a helper function contains the logic for subtraction, unrolled over the limbs
+ *
+ * @param num1 a fixed_bigint
+ * @param num2 a fixed_bigint to be subtracted
+ * @return fixed_bigint the difference modulo 2^Bits
+ */
+template <size_t Bits>
+template <size_t... I>
+constexpr fixed_bigint<Bits> fixed_bigint<Bits>::subtract(const fixed_bigint &num1, const fixed_bigint &num2, std::index_sequence<I...>)
+{
+    fixed_bigint result;
+    uint64_t borrow = 0;
+    ((result.limbs[I] = sub_limb(num1.limbs[I], num2.limbs[I], borrow)), ...);
+    return result;
+}
+
+/**
+ * @brief a helper function to add num1.limbs[I] * num2 into result, dropping limbs past the width
+ *
+ * @param result the accumulated product
+ * @param num1 a fixed_bigint
+ * @param num2 a fixed_bigint
+ */
+template <size_t Bits>
+template <size_t I, size_t... J>
+constexpr void fixed_bigint<Bits>::multiply_row(fixed_bigint &result, const fixed_bigint &num1, const fixed_bigint &num2, std::index_sequence<J...>)
+{
+    uint64_t carry = 0;
+    ((result.limbs[I + J] = mul_add_limb(num1.limbs[I], num2.limbs[J], result.limbs[I + J], carry)), ...);
+}
+
+/**
+ * @brief a helper function contains the logic for long multiplication, unrolled over the limbs
+ *
+ * Two's complement products agree with unsigned products modulo 2^Bits, so no sign handling is needed.
+ *
+ * @param num1 a fixed_bigint
+ * @param num2 a fixed_bigint
+ * @return fixed_bigint the product modulo 2^Bits
+ */
+template <size_t Bits>
+template <size_t... I>
+constexpr fixed_bigint<Bits> fixed_bigint<Bits>::multiply(const fixed_bigint &num1, const fixed_bigint &num2, std::index_sequence<I...>)
+{
+    fixed_bigint result;
+    (multiply_row<I>(result, num1, num2, std::make_index_sequence<limb_count - I>()), ...);
+    return result;
+}
+
+/**
+ * @brief a helper function to compare every limb for equality
+ *
+ * @param num1 a fixed_bigint
+ * @param num2 a fixed_bigint
+ * @return true if all limbs are equal
+ * @return false otherwise
+ */
+template <size_t Bits>
+template <size_t... I>
+constexpr bool fixed_bigint<Bits>::is_equal(const fixed_bigint &num1, const fixed_bigint &num2, std::index_sequence<I...>)
+{
+    return ((num1.limbs[I] == num2.limbs[I]) && ...);
+}
+
+/**
+ * @brief a helper function to compare the limbs as one unsigned number
+ *
+ * @param num1 a fixed_bigint
+ * @param num2 a fixed_bigint
+ * @return int -1, 0 or 1 for num1 < num2, num1 == num2, num1 > num2
+ */
+template <size_t Bits>
+template <size_t... I>
+constexpr int fixed_bigint<Bits>::compare_unsigned(const fixed_bigint &num1, const fixed_bigint &num2, std::index_sequence<I...>)
+{
+    int order = 0;
+    ((order = compare_limb(order, num1.limbs[limb_count - 1 - I], num2.limbs[limb_count - 1 - I])), ...);
+    return order;
+}
+
+/**
+ * @brief a helper function to compute *this * m + a in place, as an unsigned number
+ *
+ * @param m a limb multiplier
+ * @param a a limb addend
+ * @return uint64_t the limb carried out of the most significant limb
+ */
+template <size_t Bits>
+template <size_t... I>
+constexpr uint64_t fixed_bigint<Bits>::multiply_add_small(uint64_t m, uint64_t a, std::index_sequence<I...>)
+{
+    uint64_t carry = a;
+    ((limbs[I] = mul_add_limb(limbs[I], m, 0, carry)), ...);
+    return carry;
+}
+
+/**
+ * @brief a helper function to divide in place by a limb, as an unsigned number
+ *
+ * @param d a non-zero limb divisor
+ * @return uint64_t the remainder
+ */
+template <size_t Bits>
+template <size_t... I>
+constexpr uint64_t fixed_bigint<Bits>::divide_small(uint64_t d, std::index_sequence<I...>)
+{
+    bigint_double_limb remainder = 0;
+    ((remainder = (remainder << bigint_limb_bits) | limbs[limb_count - 1 - I],
+      limbs[limb_count - 1 - I] = uint64_t(remainder / d),
+      remainder %= d),
+     ...);
+    return uint64_t(remainder);
+}
+
+/**
+ * @brief a helper function to append a decimal digit to the unsigned magnitude being parsed
+ *
+ * @param digit a digit between 0 and 9
+ */
+template <size_t Bits>
+constexpr void fixed_bigint<Bits>::push_digit(uint64_t digit)
+{
+    if (multiply_add_small(10, digit, std::make_index_sequence<limb_count>()) != 0)
+    {
+        throw std::overflow_error("Value does not fit in fixed_bigint");
+    }
+}
+
+/**
+ * @brief a helper function to negate the parsed magnitude if needed, checking that the result fits
+ *
+ * @param negative true if the value is negative
+ */
+template <size_t Bits>
+constexpr void fixed_bigint<Bits>::apply_sign(bool negative)
+{
+    if (is_negative())
+    {
+        // only -2^(Bits-1) has a magnitude with the sign bit set
+        fixed_bigint min;
+        min.limbs[limb_count - 1] = uint64_t(1) << 63;
+        if (!negative || *this != min)
+        {
+            throw std::overflow_error("Value does not fit in fixed_bigint");
+        }
+    }
+    if (negative)
+    {
+        *this = -*this;
+    }
+}
+
+/**
+ * @brief the decimal digits of the magnitude, found by dividing by 10^19 one limb at a time
+ *
+ * @return std::vector<int8_t> the digits in little endian order, at least one digit
+ */
+template <size_t Bits>
+std::vector<int8_t> fixed_bigint<Bits>::decimal() const
+{
+    constexpr uint64_t chunk = 10000000000000000000ULL; // 10^19, the largest power of 10 in a limb
+    fixed_bigint magnitude = is_negative() ? -*this : *this;
+    std::vector<int8_t> digits;
+
+    do
+    {
+        uint64_t remainder = magnitude.divide_small(chunk, std::make_index_sequence<limb_count>());
+        for (int i = 0; i < 19; i++)
+        {
+            digits.push_back(int8_t(remainder % 10));
+            remainder /= 10;
+        }
+    } while (magnitude != fixed_bigint());
+
+    // Remove leading zeros
+    while (digits.size() > 1 && digits.back() == 0)
+    {
+        digits.pop_back();
+    }
+    return digits;
+}
+
+/**
+ * @brief check the sign bit
+ *
+ * @return true if the value is negative
+ * @return false if the value is positive or zero
+ */
+template <size_t Bits>
+constexpr bool fixed_bigint<Bits>::is_negative() const
+{
+    return (limbs[limb_count - 1] >> 63) != 0;
+}
+
+/**
+ * @brief Overload the - operator to perform subtraction of two fixed_bigints, wrapping modulo 2^Bits
+ *
+ * @param other a fixed_bigint to be subtracted
+ * @return fixed_bigint the result of the subtraction
+ */
+template <size_t Bits>
+constexpr fixed_bigint<Bits> fixed_bigint<Bits>::operator-(const fixed_bigint &other) const
+{
+    return subtract(*this, other, std::make_index_sequence<limb_count>());
+}
+
+/**
+ * @brief Overload the -= operator to perform subtraction of two fixed_bigints use operator-()
+ *
+ * @param other a fixed_bigint to be subtracted
+ * @return fixed_bigint the result of the subtraction
+ */
+template <size_t Bits>
+constexpr fixed_bigint<Bits> fixed_bigint<Bits>::operator-=(const fixed_bigint &other)
+{
+    *this = *this - other;
+    return *this;
+}
+
+/**
+ * @brief Overload the + operator to perform addition of two fixed_bigints, wrapping modulo 2^Bits
+ *
+ * @param other a fixed_bigint to be added
+ * @return fixed_bigint the result of the addition
+ */
+template <size_t Bits>
+constexpr fixed_bigint<Bits> fixed_bigint<Bits>::operator+(const fixed_bigint &other) const
+{
+    return add(*this, other, std::make_index_sequence<limb_count>());
+}
+
+/**
+ * @brief Overload the += operator to perform addition of two fixed_bigints use operator+()
+ *
+ * @param other a fixed_bigint to be added
+ * @return fixed_bigint the result of the addition
+ */
+template <size_t Bits>
+constexpr fixed_bigint<Bits> fixed_bigint<Bits>::operator+=(const fixed_bigint &other)
+{
+    *this = *this + other;
+    return *this;
+}
+
+/**
+ * @brief Overload the * operator to perform multiplication of two fixed_bigints, wrapping modulo 2^Bits
+ *
+ * @param other a fixed_bigint to be multiplied
+ * @return fixed_bigint the result of the multiplication
+ */
+template <size_t Bits>
+constexpr fixed_bigint<Bits> fixed_bigint<Bits>::operator*(const fixed_bigint &other) const
+{
+    return multiply(*this, other, std::make_index_sequence<limb_count>());
+}
+
+/**
+ * @brief Overload the *= operator to perform multiplication of two fixed_bigints use operator*()
+ *
+ * @param other a fixed_bigint to be multiplied
+ * @return fixed_bigint the result of the multiplication
+ */
+template <size_t Bits>
+constexpr fixed_bigint<Bits> fixed_bigint<Bits>::operator*=(const fixed_bigint &other)
+{
+    *this = *this * other;
+    return *this;
+}
+
+/**
+ * @brief Overload the - operator to negate a fixed_bigint, -(-2^(Bits-1)) wraps to itself
+ *
+ * @return fixed_bigint the negated fixed_bigint
+ */
+template <size_t Bits>
+constexpr fixed_bigint<Bits> fixed_bigint<Bits>::operator-() const
+{
+    return fixed_bigint() - *this;
+}
+
+/**
+ * @brief Overload the == operator to compare two fixed_bigints
+ *
+ * @param other a fixed_bigint to be compared
+ * @return true if the two fixed_bigints are equal
+ * @return false if the two fixed_bigints are not equal
+ */
+template <size_t Bits>
+constexpr bool fixed_bigint<Bits>::operator==(const fixed_bigint &other) const
+{
+    return is_equal(*this, other, std::make_index_sequence<limb_count>());
+}
+
+/**
+ * @brief Overload the != operator to compare two fixed_bigints
+ *
+ * @param other a fixed_bigint to be compared
+ * @return true if the two fixed_bigints are not equal
+ * @return false if the two fixed_bigints are equal
+ */
+template <size_t Bits>
+constexpr bool fixed_bigint<Bits>::operator!=(const fixed_bigint &other) const
+{
+    return !(*this == other);
+}
+
+/**
+ * @brief Overload the < operator to compare two fixed_bigints
+ *
+ * @param other a fixed_bigint to be compared
+ * @return true if the first fixed_bigint is smaller than the second fixed_bigint
+ * @return false if the first fixed_bigint is larger than or equal to the second fixed_bigint
+ */
+template <size_t Bits>
+constexpr bool fixed_bigint<Bits>::operator<(const fixed_bigint &other) const
+{
+    if (is_negative() != other.is_negative())
+    {
+        return is_negative(); // negative is always smaller than positive
+    }
+    // with equal signs two's complement order is unsigned order
+    return compare_unsigned(*this, other, std::make_index_sequence<limb_count>()) < 0;
+}
+
+/**
+ * @brief Overload the <= operator to compare two fixed_bigints
+ *
+ * @param other a fixed_bigint to be compared
+ * @return true if the first fixed_bigint is smaller than or equal to the second fixed_bigint
+ * @return false if the first fixed_bigint is larger than the second fixed_bigint
+ */
+template <size_t Bits>
+constexpr bool fixed_bigint<Bits>::operator<=(const fixed_bigint &other) const
+{
+    return !(other < *this);
+}
+
+/**
+ * @brief Overload the > operator to compare two fixed_bigints
+ *
+ * @param other a fixed_bigint to be compared
+ * @return true if the first fixed_bigint is larger than the second fixed_bigint
+ * @return false if the first fixed_bigint is smaller than or equal to the second fixed_bigint
+ */
+template <size_t Bits>
+constexpr bool fixed_bigint<Bits>::operator>(const fixed_bigint &other) const
+{
+    return other < *this;
+}
+
+/**
+ * @brief Overload the >= operator to compare two fixed_bigints
+ *
+ * @param other a fixed_bigint to be compared
+ * @return true if the first fixed_bigint is larger than or equal to the second fixed_bigint
+ * @return false if the first fixed_bigint is smaller than the second fixed_bigint
+ */
+template <size_t Bits>
+constexpr bool fixed_bigint<Bits>::operator>=(const fixed_bigint &other) const
+{
+    return !(*this < other);
+}
+
+/**
+ * @brief Overload the << operator to print a fixed_bigint to an output stream
+ *
+ * @param os an output stream
+ * @param num a fixed_bigint to be inserted
+ * @return std::ostream& the output stream
+ */
+template <size_t Bits>
+std::ostream &operator<<(std::ostream &os, const fixed_bigint<Bits> &num)
+{
+    if (num.is_negative())
+    {
+        os << '-';
+    }
+
+    std::vector<int8_t> digits = num.decimal();
+    for (size_t i = digits.size(); i > 0; i--)
+    {
+        os << char('0' + digits[i - 1]);
+    }
+    return os;
+}
+
+/**
+ * @brief Overload the ++ operator to increment a fixed_bigint
+ *
+ * @return fixed_bigint the pre-incremented fixed_bigint
+ */
+template <size_t Bits>
+constexpr fixed_bigint<Bits> fixed_bigint<Bits>::operator++()
+{
+    *this = *this + 1;
+    return *this;
+}
+
+/**
+ * @brief Overload the -- operator to decrement a fixed_bigint
+ *
+ * @return fixed_bigint the pre-decremented fixed_bigint
+ */
+template <size_t Bits>
+constexpr fixed_bigint<Bits> fixed_bigint<Bits>::operator--()
+{
+    *this = *this - 1;
+    return *this;
+}
+
+/**
+ * @brief Overload the ++ operator to increment a fixed_bigint
+ *
+ * @param int
+ * @return fixed_bigint the post-incremented fixed_bigint
+ */
+template <size_t Bits>
+constexpr fixed_bigint<Bits> fixed_bigint<Bits>::operator++(int)
+{
+    fixed_bigint temp = *this;
+    ++(*this);
+    return temp;
+}
+
+/**
+ * @brief Overload the -- operator to decrement a fixed_bigint
+ *
+ * @param int
+ * @return fixed_bigint the post-decremented fixed_bigint
+ */
+template <size_t Bits>
+constexpr fixed_bigint<Bits> fixed_bigint<Bits>::operator--(int)
+{
+    fixed_bigint temp = *this;
+    --(*this);
+    return temp;
+}
@@ -0,0 +1,828 @@
+/**
+ * @file radix_bigint.hpp
+ * @author Shihong Cong
+ * @brief An arbitrary-precision integer class template whose limb radix is a compile-time policy
+ * @version 0.1
+ * @date 2024-12-29
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "bigint.hpp"
+
+/**
+ * @brief the binary radix policy: limbs in base 2^64, the same storage as bigint
+ *
+ */
+struct binary_radix
+{
+    static constexpr bigint_double_limb base = bigint_double_limb(1) << bigint_limb_bits; // limb base
+    static constexpr size_t decimal_digits = 0;                                          // the base is not a power of 10
+};
+
+/**
+ * @brief the base of limbs holding a number of decimal digits
+ *
+ * @param digits decimal digits per limb, at most 19
+ * @return constexpr bigint_double_limb 10^digits
+ */
+constexpr bigint_double_limb bigint_decimal_base(size_t digits)
+{
+    bigint_double_limb power = 1;
+    for (size_t i = 0; i < digits; i++)
+    {
+        power *= 10;
+    }
+    return power;
+}
+
+/**
+ * @brief the decimal radix policy: limbs in base 10^Digits
+ *
+ * Every limb holds exactly Digits decimal digits, so parsing and printing cost one
+ * operation per limb instead of a division of the whole number per chunk.
+ *
+ * @tparam Digits decimal digits per limb, from 1 to 19 (10^19 is the largest power of 10 in a limb)
+ */
+template <size_t Digits>
+struct decimal_radix
+{
+    static_assert(Digits >= 1 && Digits <= 19, "decimal_radix must hold 1 to 19 digits per limb");
+
+    static constexpr bigint_double_limb base = bigint_decimal_base(Digits); // limb base, 10^Digits
+    static constexpr size_t decimal_digits = Digits;                        // decimal digits per limb
+};
+
+/**
+ * @brief a radix policy: a limb base between 2 and 2^64, and the decimal digits per limb if it is a power of 10
+ *
+ * A non-zero decimal_digits selects the digit-per-limb parsing and printing, so it must match the base.
+ *
+ * @tparam Radix a policy type
+ */
+template <typename Radix>
+concept bigint_radix = requires {
+    { Radix::base } -> std::convertible_to<bigint_double_limb>;
+    { Radix::decimal_digits } -> std::convertible_to<size_t>;
+} && Radix::base >= 2 && Radix::base <= binary_radix::base &&
+                       (Radix::decimal_digits == 0 ||
+                        (Radix::decimal_digits <= 19 && Radix::base == bigint_decimal_base(Radix::decimal_digits)));
+
+/**
+ * @brief An arbitrary-precision integer stored as sign and magnitude in limbs of a chosen radix
+ *
+ * radix_bigint<decimal_radix<19>> keeps 19 decimal digits per limb, so input and output are
+ * linear-time, at the cost of a division by the base in every limb product. It suits workloads
+ * that print more than they multiply. bigint remains the binary type with the full operator set;
+ * values convert both ways with the bigint_view constructor and to_bigint().
+ *
+ * @tparam Radix the limb radix policy, binary_radix or decimal_radix<Digits>
+ */
+template <bigint_radix Radix>
+class radix_bigint
+{
+public:
+    static constexpr bigint_double_limb base = Radix::base; // limb base
+
+    // Constructors
+    radix_bigint();                     // default constructor
+    radix_bigint(int64_t);              // constructor for processing int64_t
+    radix_bigint(const std::string &);  // constructor for processing string
+    explicit radix_bigint(bigint_view); // constructor for converting a bigint
+
+    // conversion
+    bigint to_bigint() const; // convert to a bigint
+
+    // Operators
+    // subtraction
+    radix_bigint operator-(const radix_bigint &) const; // subtraction
+    radix_bigint operator-=(const radix_bigint &);      // subtraction assignment
+    // addition
+    radix_bigint operator+(const radix_bigint &) const; // addition
+    radix_bigint operator+=(const radix_bigint &);      // addition assignment
+
+    // multiplication
+    radix_bigint operator*(const radix_bigint &) const; // multiplication
+    radix_bigint operator*=(const radix_bigint &);      // multiplication assignment
+
+    // negation
+    radix_bigint operator-() const; // unary negation
+
+    // comparison
+    bool operator==(const radix_bigint &) const; // equal to
+    bool operator!=(const radix_bigint &) const; // not equal to
+    bool operator<(const radix_bigint &) const;  // less than
+    bool operator<=(const radix_bigint &) const; // less than or equal to
+    bool operator>(const radix_bigint &) const;  // greater than
+    bool operator>=(const radix_bigint &) const; // greater than or equal to
+
+    // insertion
+    template <bigint_radix R>
+    friend std::ostream &operator<<(std::ostream &, const radix_bigint<R> &); // output stream
+
+    // increment and decrement
+    // pre + post
+    radix_bigint operator++(); // pre-increment
+    radix_bigint operator--(); // pre-decrement
+
+    radix_bigint operator++(int); // post-increment
+    radix_bigint operator--(int); // post-decrement
+
+private:
+    using limb_vector = std::vector<bigint_limb, bigint_allocator<bigint_limb>>;
+
+    limb_vector limbs; // little endian, each limb below base, no leading zero limbs, empty for zero
+    bool is_negative;  // true if negative, false if positive or zero
+
+    // helper functions
+    static radix_bigint signed_add(const radix_bigint &, const radix_bigint &, bool); // num1 + num2, or num1 - num2 if the flag is set
+    static limb_vector add(const limb_vector &, const limb_vector &);                 // addition of two magnitudes
+    static limb_vector subtract(const limb_vector &, const limb_vector &);            // subtraction of magnitudes, num1 >= num2
+    static int compare_magnitude(const limb_vector &, const limb_vector &);          // compare two magnitudes
+    static bigint_limb split(bigint_double_limb, bigint_limb &);                      // low limb of a double limb, the rest in carry
+    void trim();                                                                      // remove leading zero limbs, zero is never negative
+    void add_small(bigint_limb, bool);                                                // *this += m with m < base given as magnitude and sign
+    void multiply_add_small(bigint_limb, bigint_limb);                                // |*this| = |*this| * m + a for any limbs m, a
+    bigint_limb divide_small(bigint_limb);                                            // |*this| /= d, returns the remainder
+};
+
+/**
+ * @brief a helper function to split a double limb at the base
+ *
+ * @param t a value below base^2
+ * @param carry replaced by t / base
+ * @return bigint_limb t % base
+ */
+template <bigint_radix Radix>
+bigint_limb radix_bigint<Radix>::split(bigint_double_limb t, bigint_limb &carry)
+{
+    carry = bigint_limb(t / base);
+    return bigint_limb(t % base);
+}
+
+/**
+ * @brief Construct a new radix_bigint object with value 0
+ *
+ */
+template <bigint_radix Radix>
+radix_bigint<Radix>::radix_bigint()
+{
+    is_negative = false;
+}
+
+/**
+ * @brief Construct a new radix_bigint object
+ *
+ * @param val a int64_t value to be converted
+ */
+template <bigint_radix Radix>
+radix_bigint<Radix>::radix_bigint(int64_t val)
+{
+    is_negative = (val < 0);
+    bigint_limb magnitude = is_negative ? 0 - bigint_limb(val) : bigint_limb(val);
+    while (magnitude != 0)
+    {
+        limbs.push_back(bigint_limb(magnitude % base));
+        magnitude = bigint_limb(magnitude / base);
+    }
+}
+
+/**
+ * @brief Construct a new radix_bigint object
+ *
+ * With a decimal radix each limb is read directly from decimal_digits characters, starting
+ * from the least significant end. Otherwise 19 digits at a time are multiplied into the
+ * limbs, as bigint does.
+ *
+ * @param str a string of decimal digits with an optional leading '-'
+ */
+template <bigint_radix Radix>
+radix_bigint<Radix>::radix_bigint(const std::string &str)
+{
+    if (str.empty())
+    {
+        throw std::invalid_argument("Input String is Empty");
+    }
+
+    is_negative = (str[0] == '-');
+    size_t first = is_negative ? 1 : 0;
+    if (first == str.size())
+    {
+        throw std::invalid_argument("Invalid argument: " + str);
+    }
+    if (!bigint_active_kernels.all_digits(str.data() + first, str.size() - first))
+    {
+        throw std::invalid_argument("Invalid argument: " + str);
+    }
+
+    if constexpr (Radix::decimal_digits > 0)
+    {
+        limbs.reserve((str.size() - first) / Radix::decimal_digits + 1);
+        for (size_t end = str.size(); end > first;)
+        {
+            size_t begin = end - std::min(end - first, Radix::decimal_digits);
+            limbs.push_back(bigint_parse_digits(str.data() + begin, end - begin));
+            end = begin;
+        }
+    }
+    else
+    {
+        constexpr size_t chunk_digits = 19;
+        size_t chunk_size = (str.size() - first) % chunk_digits;
+        if (chunk_size == 0)
+        {
+            chunk_size = chunk_digits;
+        }
+        for (size_t i = first; i < str.size(); i += chunk_size, chunk_size = chunk_digits)
+        {
+            bigint_limb scale = 1;
+            for (size_t j = 0; j < chunk_size; j++)
+            {
+                scale *= 10;
+            }
+            multiply_add_small(scale, bigint_parse_digits(str.data() + i, chunk_size));
+        }
+    }
+    trim();
+}
+
+/**
+ * @brief Construct a new radix_bigint object from a bigint or a view
+ *
+ * A binary radix copies the limbs. Other radixes divide the absolute value by the base
+ * repeatedly, one limb per division.
+ *
+ * @param num a bigint_view to be converted
+ */
+template <bigint_radix Radix>
+radix_bigint<Radix>::radix_bigint(bigint_view num)
+{
+    num = num.trimmed();
+    is_negative = num.negative();
+    if constexpr (Radix::base == binary_radix::base)
+    {
+        limbs.assign(num.limbs().begin(), num.limbs().end());
+    }
+    else
+    {
+        bigint rest(num.abs());
+        while (!bigint_view(rest).is_zero())
+        {
+            limbs.push_back(bigint_view(rest % bigint_limb(base))[0]);
+            rest /= bigint_limb(base);
+        }
+    }
+    trim();
+}
+
+/**
+ * @brief convert to a bigint
+ *
+ * @return bigint a bigint with the same value
+ */
+template <bigint_radix Radix>
+bigint radix_bigint<Radix>::to_bigint() const
+{
+    if constexpr (Radix::base == binary_radix::base)
+    {
+        return bigint(bigint_view(limbs, is_negative));
+    }
+    else
+    {
+        bigint result;
+        for (size_t i = limbs.size(); i > 0; i--)
+        {
+            result *= bigint_limb(base);
+            result += limbs[i - 1];
+        }
+        return is_negative ? -result : result;
+    }
+}
+
+/**
+ * @brief a helper function to remove leading zero limbs and the sign of zero
+ *
+ */
+template <bigint_radix Radix>
+void radix_bigint<Radix>::trim()
+{
+    while (!limbs.empty() && limbs.back() == 0)
+    {
+        limbs.pop_back();
+    }
+    if (limbs.empty())
+    {
+        is_negative = false;
+    }
+}
+
+/**
+ * @brief a helper function to multiply the absolute value by a limb and add a limb, in place
+ *
+ * m and a may be larger than the base, as when 19 decimal digits are read into a small base,
+ * so the carry is kept in a double limb and may take several limbs at the top.
+ *
+ * @param m a multiplier
+ * @param a an addend
+ */
+template <bigint_radix Radix>
+void radix_bigint<Radix>::multiply_add_small(bigint_limb m, bigint_limb a)
+{
+    bigint_double_limb carry = a;
+    for (bigint_limb &limb : limbs)
+    {
+        bigint_double_limb t = bigint_double_limb(limb) * m + carry;
+        limb = bigint_limb(t % base);
+        carry = t / base;
+    }
+    while (carry > 0)
+    {
+        limbs.push_back(bigint_limb(carry % base));
+        carry /= base;
+    }
+}
+
+/**
+ * @brief a helper function to divide the absolute value by a limb, in place
+ *
+ * @param d a non-zero divisor
+ * @return bigint_limb the remainder
+ */
+template <bigint_radix Radix>
+bigint_limb radix_bigint<Radix>::divide_small(bigint_limb d)
+{
+    bigint_double_limb remainder = 0;
+    for (size_t i = limbs.size(); i > 0; i--)
+    {
+        remainder = remainder * base + limbs[i - 1];
+        limbs[i - 1] = bigint_limb(remainder / d);
+        remainder %= d;
+    }
+    trim();
+    return bigint_limb(remainder);
+}
+
+/**
+ * @brief a helper function to add a signed limb in place, stopping as soon as the carry or borrow dies out
+ *
+ * @param m the absolute value of the addend, below base
+ * @param negative true if the addend is negative
+ */
+template <bigint_radix Radix>
+void radix_bigint<Radix>::add_small(bigint_limb m, bool negative)
+{
+    if (m == 0)
+    {
+        return;
+    }
+    if (limbs.empty())
+    {
+        limbs.push_back(m);
+        is_negative = negative;
+    }
+    else if (negative == is_negative)
+    {
+        for (size_t i = 0; m != 0; i++)
+        {
+            if (i == limbs.size())
+            {
+                limbs.push_back(m);
+                break;
+            }
+            limbs[i] = split(bigint_double_limb(limbs[i]) + m, m);
+        }
+    }
+    else if (limbs.size() > 1 || limbs[0] >= m)
+    {
+        for (size_t i = 0; m != 0; i++)
+        {
+            bigint_limb borrow = limbs[i] < m ? 1 : 0;
+            limbs[i] = bigint_limb(bigint_double_limb(limbs[i]) + borrow * base - m);
+            m = borrow;
+        }
+        trim();
+    }
+    else
+    {
+        limbs[0] = m - limbs[0];
+        is_negative = negative;
+    }
+}
+
+/**
+ * @brief a helper function to compare the absolute values of two numbers
+ *
+ * @param num1 a magnitude
+ * @param num2 a magnitude
+ * @return int -1, 0 or 1 for |num1| < |num2|, |num1| == |num2|, |num1| > |num2|
+ */
+template <bigint_radix Radix>
+int radix_bigint<Radix>::compare_magnitude(const limb_vector &num1, const limb_vector &num2)
+{
+    if (num1.size() != num2.size())
+    {
+        return num1.size() < num2.size() ? -1 : 1;
+    }
+    for (size_t i = num1.size(); i > 0; i--)
+    {
+        if (num1[i - 1] != num2[i - 1])
+        {
+            return num1[i - 1] < num2[i - 1] ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief a helper function contains the logic for addition of two magnitudes
+ *
+ * @param num1 a magnitude
+ * @param num2 a magnitude
+ * @return limb_vector the sum
+ */
+template <bigint_radix Radix>
+typename radix_bigint<Radix>::limb_vector radix_bigint<Radix>::add(const limb_vector &num1, const limb_vector &num2)
+{
+    const limb_vector &longer = num1.size() >= num2.size() ? num1 : num2;
+    const limb_vector &shorter = num1.size() >= num2.size() ? num2 : num1;
+    limb_vector result;
+    result.reserve(longer.size() + 1);
+
+    bigint_limb carry = 0;
+    for (size_t i = 0; i < longer.size(); i++)
+    {
+        bigint_double_limb sum = bigint_double_limb(longer[i]) + (i < shorter.size() ? shorter[i] : 0) + carry;
+        carry = sum >= base ? 1 : 0;
+        result.push_back(bigint_limb(sum - carry * base));
+    }
+    if (carry > 0)
+    {
+        result.push_back(carry);
+    }
+    return result;
+}
+
+/**
+ * @brief a helper function contains the logic for subtraction of two magnitudes
+ *
+ * @param num1 a magnitude
+ * @param num2 a magnitude no larger than num1
+ * @return limb_vector the difference, possibly with leading zero limbs
+ */
+template <bigint_radix Radix>
+typename radix_bigint<Radix>::limb_vector radix_bigint<Radix>::subtract(const limb_vector &num1, const limb_vector &num2)
+{
+    limb_vector result;
+    result.reserve(num1.size());
+
+    bigint_limb borrow = 0;
+    for (size_t i = 0; i < num1.size(); i++)
+    {
+        bigint_double_limb subtrahend = bigint_double_limb(i < num2.size() ? num2[i] : 0) + borrow;
+        borrow = num1[i] < subtrahend ? 1 : 0;
+        result.push_back(bigint_limb(num1[i] + borrow * base - subtrahend));
+    }
+    return result;
+}
+
+/**
+ * @brief a helper function contains the logic for addition and subtraction of two signed numbers
+ *
+ * @param num1 a radix_bigint
+ * @param num2 a radix_bigint
+ * @param negate_num2 true to subtract num2 instead of adding it
+ * @return radix_bigint the result
+ */
+template <bigint_radix Radix>
+radix_bigint<Radix> radix_bigint<Radix>::signed_add(const radix_bigint &num1, const radix_bigint &num2, bool negate_num2)
+{
+    bool num2_negative = num2.is_negative != negate_num2;
+    radix_bigint result;
+    if (num1.is_negative == num2_negative)
+    {
+        result.limbs = add(num1.limbs, num2.limbs);
+        result.is_negative = num1.is_negative;
+    }
+    else if (compare_magnitude(num1.limbs, num2.limbs) >= 0)
+    {
+        result.limbs = subtract(num1.limbs, num2.limbs);
+        result.is_negative = num1.is_negative;
+    }
+    else
+    {
+        result.limbs = subtract(num2.limbs, num1.limbs);
+        result.is_negative = num2_negative;
+    }
+    result.trim();
+    return result;
+}
+
+/**
+ * @brief Overload the + operator to perform addition of two radix_bigints
+ *
+ * @param other a radix_bigint to be added
+ * @return radix_bigint the result of the addition
+ */
+template <bigint_radix Radix>
+radix_bigint<Radix> radix_bigint<Radix>::operator+(const radix_bigint &other) const
+{
+    return signed_add(*this, other, false);
+}
+
+/**
+ * @brief Overload the += operator to perform addition of two radix_bigints
+ *
+ * @param other a radix_bigint to be added
+ * @return radix_bigint the result of the addition
+ */
+template <bigint_radix Radix>
+radix_bigint<Radix> radix_bigint<Radix>::operator+=(const radix_bigint &other)
+{
+    *this = *this + other;
+    return *this;
+}
+
+/**
+ * @brief Overload the - operator to perform subtraction of two radix_bigints
+ *
+ * @param other a radix_bigint to be subtracted
+ * @return radix_bigint the result of the subtraction
+ */
+template <bigint_radix Radix>
+radix_bigint<Radix> radix_bigint<Radix>::operator-(const radix_bigint &other) const
+{
+    return signed_add(*this, other, true);
+}
+
+/**
+ * @brief Overload the -= operator to perform subtraction of two radix_bigints
+ *
+ * @param other a radix_bigint to be subtracted
+ * @return radix_bigint the result of the subtraction
+ */
+template <bigint_radix Radix>
+radix_bigint<Radix> radix_bigint<Radix>::operator-=(const radix_bigint &other)
+{
+    *this = *this - other;
+    return *this;
+}
+
+/**
+ * @brief Overload the * operator to perform long multiplication of two radix_bigints
+ *
+ * Each limb product is accumulated into the result in double-limb arithmetic and split at the base.
+ *
+ * @param other a radix_bigint to be multiplied
+ * @return radix_bigint the result of the multiplication
+ */
+template <bigint_radix Radix>
+radix_bigint<Radix> radix_bigint<Radix>::operator*(const radix_bigint &other) const
+{
+    radix_bigint result;
+    if (limbs.empty() || other.limbs.empty())
+    {
+        return result;
+    }
+
+    result.limbs.assign(limbs.size() + other.limbs.size(), 0);
+    for (size_t i = 0; i < limbs.size(); i++)
+    {
+        bigint_limb carry = 0;
+        for (size_t j = 0; j < other.limbs.size(); j++)
+        {
+            bigint_double_limb t = bigint_double_limb(limbs[i]) * other.limbs[j] + result.limbs[i + j] + carry;
+            result.limbs[i + j] = split(t, carry);
+        }
+        result.limbs[i + other.limbs.size()] = carry;
+    }
+
+    result.is_negative = is_negative != other.is_negative;
+    result.trim();
+    return result;
+}
+
+/**
+ * @brief Overload the *= operator to perform multiplication of two radix_bigints
+ *
+ * @param other a radix_bigint to be multiplied
+ * @return radix_bigint the result of the multiplication
+ */
+template <bigint_radix Radix>
+radix_bigint<Radix> radix_bigint<Radix>::operator*=(const radix_bigint &other)
+{
+    *this = *this * other;
+    return *this;
+}
+
+/**
+ * @brief Overload the - operator to negate a radix_bigint
+ *
+ * @return radix_bigint the negated value, zero stays non-negative
+ */
+template <bigint_radix Radix>
+radix_bigint<Radix> radix_bigint<Radix>::operator-() const
+{
+    radix_bigint result = *this;
+    result.is_negative = !is_negative && !limbs.empty();
+    return result;
+}
+
+/**
+ * @brief Overload the == operator to compare two radix_bigints
+ *
+ * @param other a radix_bigint to be compared
+ * @return true if the values are equal
+ */
+template <bigint_radix Radix>
+bool radix_bigint<Radix>::operator==(const radix_bigint &other) const
+{
+    return is_negative == other.is_negative && limbs == other.limbs;
+}
+
+/**
+ * @brief Overload the != operator to compare two radix_bigints
+ *
+ * @param other a radix_bigint to be compared
+ * @return true if the values are not equal
+ */
+template <bigint_radix Radix>
+bool radix_bigint<Radix>::operator!=(const radix_bigint &other) const
+{
+    return !(*this == other);
+}
+
+/**
+ * @brief Overload the < operator to compare two radix_bigints
+ *
+ * @param other a radix_bigint to be compared
+ * @return true if this value is less than other
+ */
+template <bigint_radix Radix>
+bool radix_bigint<Radix>::operator<(const radix_bigint &other) const
+{
+    if (is_negative != other.is_negative)
+    {
+        return is_negative;
+    }
+    int order = compare_magnitude(limbs, other.limbs);
+    return is_negative ? order > 0 : order < 0;
+}
+
+/**
+ * @brief Overload the <= operator to compare two radix_bigints
+ *
+ * @param other a radix_bigint to be compared
+ * @return true if this value is less than or equal to other
+ */
+template <bigint_radix Radix>
+bool radix_bigint<Radix>::operator<=(const radix_bigint &other) const
+{
+    return !(other < *this);
+}
+
+/**
+ * @brief Overload the > operator to compare two radix_bigints
+ *
+ * @param other a radix_bigint to be compared
+ * @return true if this value is greater than other
+ */
+template <bigint_radix Radix>
+bool radix_bigint<Radix>::operator>(const radix_bigint &other) const
+{
+    return other < *this;
+}
+
+/**
+ * @brief Overload the >= operator to compare two radix_bigints
+ *
+ * @param other a radix_bigint to be compared
+ * @return true if this value is greater than or equal to other
+ */
+template <bigint_radix Radix>
+bool radix_bigint<Radix>::operator>=(const radix_bigint &other) const
+{
+    return !(*this < other);
+}
+
+/**
+ * @brief Overload the << operator to print a radix_bigint to an output stream
+ *
+ * With a decimal radix every limb is printed directly, zero-padded to decimal_digits
+ * except the most significant one. Otherwise the value is divided by 10^19 repeatedly, as bigint does.
+ *
+ * @param os an output stream
+ * @param num a radix_bigint to be inserted
+ * @return std::ostream& the output stream
+ */
+template <bigint_radix R>
+std::ostream &operator<<(std::ostream &os, const radix_bigint<R> &num)
+{
+    std::string str;
+    if constexpr (R::decimal_digits > 0)
+    {
+        if (num.limbs.empty())
+        {
+            return os << '0';
+        }
+        if (num.is_negative)
+        {
+            str.push_back('-');
+        }
+        str += std::to_string(num.limbs.back());
+        str.reserve(str.size() + (num.limbs.size() - 1) * R::decimal_digits);
+        char padded[19];
+        for (size_t i = num.limbs.size() - 1; i > 0; i--)
+        {
+            bigint_format_19_digits(num.limbs[i - 1], padded);
+            str.append(padded + 19 - R::decimal_digits, R::decimal_digits);
+        }
+    }
+    else
+    {
+        constexpr bigint_limb chunk = 10000000000000000000ULL; // 10^19, the largest power of 10 in a limb
+        constexpr size_t chunk_digits = 19;
+
+        radix_bigint<R> magnitude = num;
+        std::vector<bigint_limb> chunks; // least significant first
+        do
+        {
+            chunks.push_back(magnitude.divide_small(chunk));
+        } while (!magnitude.limbs.empty());
+
+        str.assign(1 + chunks.size() * chunk_digits, '-');
+        for (size_t i = chunks.size(); i > 0; i--)
+        {
+            bigint_format_19_digits(chunks[i - 1], str.data() + 1 + (chunks.size() - i) * chunk_digits);
+        }
+        size_t first = std::min(str.find_first_not_of('0', 1), str.size() - 1);
+        if (num.is_negative)
+        {
+            str[--first] = '-';
+        }
+        str.erase(0, first);
+    }
+    return os << str;
+}
+
+/**
+ * @brief Overload the ++ operator to increment a radix_bigint in place
+ *
+ * @return radix_bigint the pre-incremented radix_bigint
+ */
+template <bigint_radix Radix>
+radix_bigint<Radix> radix_bigint<Radix>::operator++()
+{
+    add_small(1, false);
+    return *this;
+}
+
+/**
+ * @brief Overload the ++ operator to increment a radix_bigint
+ *
+ * @param int
+ * @return radix_bigint the value before the increment
+ */
+template <bigint_radix Radix>
+radix_bigint<Radix> radix_bigint<Radix>::operator++(int)
+{
+    radix_bigint temp = *this;
+    ++(*this);
+    return temp;
+}
+
+/**
+ * @brief Overload the -- operator to decrement a radix_bigint in place
+ *
+ * @return radix_bigint the pre-decremented radix_bigint
+ */
+template <bigint_radix Radix>
+radix_bigint<Radix> radix_bigint<Radix>::operator--()
+{
+    add_small(1, true);
+    return *this;
+}
+
+/**
+ * @brief Overload the -- operator to decrement a radix_bigint
+ *
+ * @param int
+ * @return radix_bigint the value before the decrement
+ */
+template <bigint_radix Radix>
+radix_bigint<Radix> radix_bigint<Radix>::operator--(int)
+{
+    radix_bigint temp = *this;
+    --(*this);
+    return temp;
+}
+
+using decimal_bigint = radix_bigint<decimal_radix<19>>; // 19 decimal digits per limb, linear-time decimal I/O
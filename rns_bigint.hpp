@@ -0,0 +1,535 @@
+/**
+ * @file rns_bigint.hpp
+ * @author Shihong Cong
+ * @brief A residue number system representation for multiply-heavy workloads
+ * @version 0.1
+ * @date 2024-12-29
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#pragma once
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+#include "bigint.hpp"
+#include "bigint_prime.hpp"
+
+/**
+ * @brief a set of pairwise coprime word-size moduli and the constants for converting to and from them
+ *
+ * Each modulus m is odd and below 2^63, and keeps its own Montgomery constants, so a residue
+ * product is three 64-bit multiplications instead of a 128-bit division. The basis represents
+ * integers in (-M/2, M/2], where M is the product of the moduli.
+ */
+class rns_basis
+{
+public:
+    // Constructors
+    explicit rns_basis(std::vector<uint64_t>); // pairwise coprime odd moduli below 2^63
+    static rns_basis with_capacity(size_t);    // the largest primes below 2^62 that hold any signed value of the given bits
+
+    // access
+    const std::vector<uint64_t> &moduli() const; // the moduli
+    const bigint &product() const;               // M, the product of the moduli
+    size_t size() const;                         // number of moduli
+
+    // residue arithmetic, in Montgomery form modulo moduli()[i]
+    uint64_t add(size_t, uint64_t, uint64_t) const;      // a + b mod m
+    uint64_t subtract(size_t, uint64_t, uint64_t) const; // a - b mod m
+    uint64_t multiply(size_t, uint64_t, uint64_t) const; // a * b / 2^64 mod m
+    uint64_t to_montgomery(size_t, uint64_t) const;      // a * 2^64 mod m for a < m
+    uint64_t from_montgomery(size_t, uint64_t) const;    // a / 2^64 mod m
+
+    // conversion
+    std::vector<uint64_t> to_residues(bigint_view) const;   // x mod each modulus, in Montgomery form
+    bigint from_residues(const std::vector<uint64_t> &) const; // the value in (-M/2, M/2] with these residues
+
+private:
+    std::vector<uint64_t> mods;                   // the moduli
+    std::vector<uint64_t> m_prime;                // -m^-1 mod 2^64 for each modulus
+    std::vector<uint64_t> r_squared;              // 2^128 mod m for each modulus
+    std::vector<std::vector<uint64_t>> inverses;  // inverses[j][i] = m_j^-1 mod m_i in Montgomery form, j < i
+    bigint modulus_product;                       // M
+    bigint half_product;                          // floor(M / 2)
+
+    uint64_t reduce(size_t, bigint_double_limb) const; // Montgomery reduction of t < m * 2^64
+};
+
+/**
+ * @brief An integer held as its residues modulo the moduli of an rns_basis
+ *
+ * Addition, subtraction and multiplication work on each residue independently, in time linear
+ * in the number of moduli, with no carries between them, so every loop can be split across
+ * threads or vector lanes. The results are exact as long as every intermediate value stays in
+ * (-M/2, M/2]; choose the basis with rns_basis::with_capacity for the largest value expected.
+ * Converting to and from bigint (Chinese remaindering) is quadratic, so long chains of
+ * operations should convert only at their ends. The basis must outlive every rns_bigint using it.
+ */
+class rns_bigint
+{
+public:
+    // Constructors
+    rns_bigint(bigint_view, const rns_basis &); // convert a bigint into residues
+
+    // conversion
+    bigint to_bigint() const;                       // convert back with the Chinese remainder theorem
+    const std::vector<uint64_t> &residues() const;  // residues in Montgomery form
+    const rns_basis &basis() const;                 // the basis
+
+    // Operators
+    rns_bigint operator+(const rns_bigint &) const; // addition
+    rns_bigint operator+=(const rns_bigint &);      // addition assignment
+    rns_bigint operator-(const rns_bigint &) const; // subtraction
+    rns_bigint operator-=(const rns_bigint &);      // subtraction assignment
+    rns_bigint operator*(const rns_bigint &) const; // multiplication
+    rns_bigint operator*=(const rns_bigint &);      // multiplication assignment
+    rns_bigint operator-() const;                   // unary negation
+
+    // comparison
+    bool operator==(const rns_bigint &) const; // equal to
+    bool operator!=(const rns_bigint &) const; // not equal to
+
+private:
+    const rns_basis *base_set;      // the moduli, owned elsewhere
+    std::vector<uint64_t> values;   // one residue per modulus, in Montgomery form
+
+    void check_basis(const rns_bigint &) const; // throw unless both use the same basis
+};
+
+/**
+ * @brief a helper function to invert a number modulo another with the extended Euclidean algorithm
+ *
+ * @param a a number coprime to m
+ * @param m a modulus greater than 1
+ * @return uint64_t a^-1 mod m
+ */
+inline uint64_t rns_inverse(uint64_t a, uint64_t m)
+{
+    __extension__ typedef __int128 signed_double_limb;
+    signed_double_limb old_r = a % m, r = m, old_s = 1, s = 0;
+    while (r != 0)
+    {
+        signed_double_limb q = old_r / r;
+        signed_double_limb t = old_r - q * r;
+        old_r = r;
+        r = t;
+        t = old_s - q * s;
+        old_s = s;
+        s = t;
+    }
+    if (old_r != 1)
+    {
+        throw std::invalid_argument("RNS moduli must be pairwise coprime");
+    }
+    return uint64_t(old_s < 0 ? old_s + m : old_s);
+}
+
+/**
+ * @brief Construct a new rns_basis object and precompute its constants
+ *
+ * @param moduli pairwise coprime odd moduli, each greater than 1 and below 2^63
+ */
+inline rns_basis::rns_basis(std::vector<uint64_t> moduli) : mods(std::move(moduli)), modulus_product(1)
+{
+    if (mods.empty())
+    {
+        throw std::invalid_argument("RNS basis needs at least one modulus");
+    }
+    for (uint64_t m : mods)
+    {
+        if (m < 3 || m % 2 == 0 || m >> 63 != 0)
+        {
+            throw std::invalid_argument("RNS moduli must be odd, greater than 1 and below 2^63");
+        }
+
+        // Newton's iteration doubles the correct low bits of the inverse, starting from 3
+        uint64_t inverse = m;
+        for (int i = 0; i < 5; i++)
+        {
+            inverse *= 2 - m * inverse;
+        }
+        m_prime.push_back(0 - inverse);
+        uint64_t r = (0 - m) % m; // 2^64 mod m
+        r_squared.push_back(uint64_t(bigint_double_limb(r) * r % m));
+        modulus_product *= m;
+    }
+    half_product = modulus_product >> 1;
+
+    inverses.resize(mods.size());
+    for (size_t j = 0; j < mods.size(); j++)
+    {
+        for (size_t i = j + 1; i < mods.size(); i++)
+        {
+            inverses[j].push_back(to_montgomery(i, rns_inverse(mods[j] % mods[i], mods[i])));
+        }
+    }
+}
+
+/**
+ * @brief a basis of the largest primes below 2^62 with enough capacity for a number of bits
+ *
+ * @param bits the largest bit length of any value, its sign excluded
+ * @return rns_basis a basis with M > 2^(bits + 1)
+ */
+inline rns_basis rns_basis::with_capacity(size_t bits)
+{
+    std::vector<uint64_t> moduli;
+    size_t capacity = 0;
+    uint64_t candidate = (uint64_t(1) << 62) - 1;
+    while (capacity <= bits + 1)
+    {
+        while (!is_probable_prime(bigint(int64_t(candidate))))
+        {
+            candidate -= 2;
+        }
+        moduli.push_back(candidate);
+        capacity += 61; // each prime is above 2^61
+        candidate -= 2;
+    }
+    return rns_basis(std::move(moduli));
+}
+
+/**
+ * @brief the moduli of the basis
+ *
+ * @return const std::vector<uint64_t>& the moduli
+ */
+inline const std::vector<uint64_t> &rns_basis::moduli() const
+{
+    return mods;
+}
+
+/**
+ * @brief the product of the moduli
+ *
+ * @return const bigint& M
+ */
+inline const bigint &rns_basis::product() const
+{
+    return modulus_product;
+}
+
+/**
+ * @brief the number of moduli
+ *
+ * @return size_t the number of residues of every rns_bigint in this basis
+ */
+inline size_t rns_basis::size() const
+{
+    return mods.size();
+}
+
+/**
+ * @brief a helper function for Montgomery reduction modulo one modulus
+ *
+ * @param i the index of the modulus
+ * @param t a value below m * 2^64
+ * @return uint64_t t / 2^64 mod m
+ */
+inline uint64_t rns_basis::reduce(size_t i, bigint_double_limb t) const
+{
+    uint64_t q = uint64_t(t) * m_prime[i];
+    uint64_t result = uint64_t((t + bigint_double_limb(q) * mods[i]) >> bigint_limb_bits);
+    return result >= mods[i] ? result - mods[i] : result;
+}
+
+/**
+ * @brief add two residues
+ *
+ * @param i the index of the modulus
+ * @param a a residue
+ * @param b a residue
+ * @return uint64_t a + b mod m, which cannot overflow since m < 2^63
+ */
+inline uint64_t rns_basis::add(size_t i, uint64_t a, uint64_t b) const
+{
+    uint64_t sum = a + b;
+    return sum >= mods[i] ? sum - mods[i] : sum;
+}
+
+/**
+ * @brief subtract two residues
+ *
+ * @param i the index of the modulus
+ * @param a a residue
+ * @param b a residue to be subtracted
+ * @return uint64_t a - b mod m
+ */
+inline uint64_t rns_basis::subtract(size_t i, uint64_t a, uint64_t b) const
+{
+    return a >= b ? a - b : a + mods[i] - b;
+}
+
+/**
+ * @brief multiply two residues in Montgomery form
+ *
+ * @param i the index of the modulus
+ * @param a a residue
+ * @param b a residue
+ * @return uint64_t a * b / 2^64 mod m
+ */
+inline uint64_t rns_basis::multiply(size_t i, uint64_t a, uint64_t b) const
+{
+    return reduce(i, bigint_double_limb(a) * b);
+}
+
+/**
+ * @brief convert a residue into Montgomery form
+ *
+ * @param i the index of the modulus
+ * @param a a value below m
+ * @return uint64_t a * 2^64 mod m
+ */
+inline uint64_t rns_basis::to_montgomery(size_t i, uint64_t a) const
+{
+    return reduce(i, bigint_double_limb(a) * r_squared[i]);
+}
+
+/**
+ * @brief convert a residue out of Montgomery form
+ *
+ * @param i the index of the modulus
+ * @param a a residue in Montgomery form
+ * @return uint64_t a / 2^64 mod m
+ */
+inline uint64_t rns_basis::from_montgomery(size_t i, uint64_t a) const
+{
+    return reduce(i, a);
+}
+
+/**
+ * @brief reduce a number modulo every modulus
+ *
+ * @param x a number
+ * @return std::vector<uint64_t> x mod m for each modulus, in Montgomery form
+ */
+inline std::vector<uint64_t> rns_basis::to_residues(bigint_view x) const
+{
+    std::vector<uint64_t> residues(size());
+    bigint magnitude(x.abs());
+    for (size_t i = 0; i < size(); i++)
+    {
+        uint64_t r = bigint_view(magnitude % mods[i])[0];
+        if (x.negative() && r != 0)
+        {
+            r = mods[i] - r;
+        }
+        residues[i] = to_montgomery(i, r);
+    }
+    return residues;
+}
+
+/**
+ * @brief rebuild a number from its residues with Garner's algorithm
+ *
+ * The residues are turned into mixed-radix digits d_i, so that x = d_0 + d_1 m_0 + d_2 m_0 m_1 + ...,
+ * using only word-size arithmetic and the precomputed inverses. The digits are then combined by
+ * Horner's rule with single-limb bigint operations, which needs no bigint division.
+ *
+ * @param residues one residue per modulus, in Montgomery form
+ * @return bigint the number in (-M/2, M/2] with these residues
+ */
+inline bigint rns_basis::from_residues(const std::vector<uint64_t> &residues) const
+{
+    std::vector<uint64_t> digits(size());
+    for (size_t i = 0; i < size(); i++)
+    {
+        uint64_t digit = from_montgomery(i, residues[i]);
+        for (size_t j = 0; j < i; j++)
+        {
+            // the inverse is in Montgomery form, so the product comes out in normal form
+            digit = multiply(i, subtract(i, digit, digits[j] % mods[i]), inverses[j][i - j - 1]);
+        }
+        digits[i] = digit;
+    }
+
+    bigint result;
+    for (size_t i = size(); i > 0; i--)
+    {
+        result *= mods[i - 1];
+        result += digits[i - 1];
+    }
+    if (result > half_product)
+    {
+        result -= modulus_product;
+    }
+    return result;
+}
+
+/**
+ * @brief Construct a new rns_bigint object
+ *
+ * @param num a number in (-M/2, M/2]
+ * @param basis the moduli, which must outlive the object
+ */
+inline rns_bigint::rns_bigint(bigint_view num, const rns_basis &basis) : base_set(&basis), values(basis.to_residues(num)) {}
+
+/**
+ * @brief convert back to a bigint
+ *
+ * @return bigint the value in (-M/2, M/2] with these residues
+ */
+inline bigint rns_bigint::to_bigint() const
+{
+    return base_set->from_residues(values);
+}
+
+/**
+ * @brief the residues
+ *
+ * @return const std::vector<uint64_t>& one residue per modulus, in Montgomery form
+ */
+inline const std::vector<uint64_t> &rns_bigint::residues() const
+{
+    return values;
+}
+
+/**
+ * @brief the basis
+ *
+ * @return const rns_basis& the moduli of the residues
+ */
+inline const rns_basis &rns_bigint::basis() const
+{
+    return *base_set;
+}
+
+/**
+ * @brief a helper function to check that two numbers share a basis
+ *
+ * @param other an rns_bigint
+ */
+inline void rns_bigint::check_basis(const rns_bigint &other) const
+{
+    if (base_set != other.base_set)
+    {
+        throw std::invalid_argument("rns_bigint operands use different bases");
+    }
+}
+
+/**
+ * @brief Overload the += operator to add residue by residue
+ *
+ * @param other an rns_bigint in the same basis
+ * @return rns_bigint the result of the addition
+ */
+inline rns_bigint rns_bigint::operator+=(const rns_bigint &other)
+{
+    check_basis(other);
+    for (size_t i = 0; i < values.size(); i++)
+    {
+        values[i] = base_set->add(i, values[i], other.values[i]);
+    }
+    return *this;
+}
+
+/**
+ * @brief Overload the + operator to add residue by residue
+ *
+ * @param other an rns_bigint in the same basis
+ * @return rns_bigint the result of the addition
+ */
+inline rns_bigint rns_bigint::operator+(const rns_bigint &other) const
+{
+    rns_bigint result = *this;
+    result += other;
+    return result;
+}
+
+/**
+ * @brief Overload the -= operator to subtract residue by residue
+ *
+ * @param other an rns_bigint in the same basis
+ * @return rns_bigint the result of the subtraction
+ */
+inline rns_bigint rns_bigint::operator-=(const rns_bigint &other)
+{
+    check_basis(other);
+    for (size_t i = 0; i < values.size(); i++)
+    {
+        values[i] = base_set->subtract(i, values[i], other.values[i]);
+    }
+    return *this;
+}
+
+/**
+ * @brief Overload the - operator to subtract residue by residue
+ *
+ * @param other an rns_bigint in the same basis
+ * @return rns_bigint the result of the subtraction
+ */
+inline rns_bigint rns_bigint::operator-(const rns_bigint &other) const
+{
+    rns_bigint result = *this;
+    result -= other;
+    return result;
+}
+
+/**
+ * @brief Overload the *= operator to multiply residue by residue
+ *
+ * @param other an rns_bigint in the same basis
+ * @return rns_bigint the result of the multiplication
+ */
+inline rns_bigint rns_bigint::operator*=(const rns_bigint &other)
+{
+    check_basis(other);
+    for (size_t i = 0; i < values.size(); i++)
+    {
+        values[i] = base_set->multiply(i, values[i], other.values[i]);
+    }
+    return *this;
+}
+
+/**
+ * @brief Overload the * operator to multiply residue by residue
+ *
+ * @param other an rns_bigint in the same basis
+ * @return rns_bigint the result of the multiplication
+ */
+inline rns_bigint rns_bigint::operator*(const rns_bigint &other) const
+{
+    rns_bigint result = *this;
+    result *= other;
+    return result;
+}
+
+/**
+ * @brief Overload the - operator to negate every residue
+ *
+ * @return rns_bigint the negated value
+ */
+inline rns_bigint rns_bigint::operator-() const
+{
+    rns_bigint result = *this;
+    for (size_t i = 0; i < values.size(); i++)
+    {
+        result.values[i] = base_set->subtract(i, 0, values[i]);
+    }
+    return result;
+}
+
+/**
+ * @brief Overload the == operator, equal values have equal residues
+ *
+ * @param other an rns_bigint in the same basis
+ * @return true if the values are equal
+ */
+inline bool rns_bigint::operator==(const rns_bigint &other) const
+{
+    check_basis(other);
+    return values == other.values;
+}
+
+/**
+ * @brief Overload the != operator
+ *
+ * @param other an rns_bigint in the same basis
+ * @return true if the values are not equal
+ */
+inline bool rns_bigint::operator!=(const rns_bigint &other) const
+{
+    return !(*this == other);
+}
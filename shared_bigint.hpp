@@ -0,0 +1,263 @@
+/**
+ * @file shared_bigint.hpp
+ * @author Shihong Cong
+ * @brief A copy-on-write handle to a bigint whose copies share one limb buffer
+ * @version 0.1
+ * @date 2024-12-29
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#pragma once
+
+#include <atomic>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+#include "bigint.hpp"
+
+/**
+ * @brief A bigint shared between copies through an atomic reference count
+ *
+ * Copying a shared_bigint costs one atomic increment, whatever the size of the number, so
+ * large constants can be handed to many threads or stored in many containers cheaply. Reads
+ * go through bigint_view, so every view operator of bigint accepts a shared_bigint directly.
+ * A mutation first makes a private copy of the number if any other shared_bigint still refers
+ * to it. Like std::shared_ptr, distinct shared_bigint objects may be used from different
+ * threads at once, but one object must not be mutated from two threads at once, nor while
+ * another thread reads it.
+ */
+class shared_bigint
+{
+public:
+    // Constructors
+    shared_bigint();                      // zero
+    shared_bigint(int64_t);               // constructor for processing int64_t
+    shared_bigint(const std::string &);   // constructor for processing string
+    shared_bigint(bigint);                // takes over a bigint, moving its limbs
+    explicit shared_bigint(bigint_view);  // copies the viewed limbs once
+
+    // access
+    operator bigint_view() const;   // read-only view of the shared number
+    const bigint &value() const;    // the shared number
+    bigint &mutate();               // the number, copied first if it is shared
+    long use_count() const;         // number of shared_bigint objects sharing the number
+
+    // Operators
+    shared_bigint &operator+=(bigint_view);    // addition assignment
+    shared_bigint &operator-=(bigint_view);    // subtraction assignment
+    shared_bigint &operator*=(bigint_view);    // multiplication assignment
+    template <bigint_native_integer T>
+    shared_bigint &operator/=(T); // division assignment truncating towards zero
+    template <bigint_native_integer T>
+    shared_bigint &operator%=(T); // remainder assignment
+    shared_bigint operator-() const;           // unary negation
+    shared_bigint &operator++();               // pre-increment
+    shared_bigint &operator--();               // pre-decrement
+
+    // insertion
+    friend std::ostream &operator<<(std::ostream &, const shared_bigint &); // output stream
+
+private:
+    std::shared_ptr<const bigint> number; // never null
+};
+
+/**
+ * @brief Construct a new shared_bigint object with the value 0
+ *
+ */
+inline shared_bigint::shared_bigint() : number(std::make_shared<bigint>()) {}
+
+/**
+ * @brief Construct a new shared_bigint object from an int64_t
+ *
+ * @param num a signed 64-bit integer
+ */
+inline shared_bigint::shared_bigint(int64_t num) : number(std::make_shared<bigint>(num)) {}
+
+/**
+ * @brief Construct a new shared_bigint object from a string of decimal digits
+ *
+ * @param str a string value to be converted
+ */
+inline shared_bigint::shared_bigint(const std::string &str) : number(std::make_shared<bigint>(str)) {}
+
+/**
+ * @brief Construct a new shared_bigint object that takes over a bigint
+ *
+ * The limbs are moved, so a result can be shared without copying it: shared_bigint(a * b).
+ *
+ * @param num a bigint to be shared
+ */
+inline shared_bigint::shared_bigint(bigint num) : number(std::make_shared<bigint>(std::move(num))) {}
+
+/**
+ * @brief Construct a new shared_bigint object from a view, copying the viewed limbs once
+ *
+ * @param view a bigint_view to be copied
+ */
+inline shared_bigint::shared_bigint(bigint_view view) : number(std::make_shared<bigint>(view)) {}
+
+/**
+ * @brief view the shared number, so that the view operators of bigint accept a shared_bigint
+ *
+ * @return bigint_view a view valid while this object refers to the number
+ */
+inline shared_bigint::operator bigint_view() const
+{
+    return bigint_view(*number);
+}
+
+/**
+ * @brief the shared number
+ *
+ * @return const bigint& a reference valid while this object refers to the number
+ */
+inline const bigint &shared_bigint::value() const
+{
+    return *number;
+}
+
+/**
+ * @brief the number for modification, copied first if another shared_bigint refers to it
+ *
+ * When the count is 1 no other object can reach the number, so it is safe to modify in place.
+ * use_count() is a relaxed load, so an acquire fence orders the writes after the reads other
+ * threads made through copies that have since been destroyed, whose release decrement it pairs with.
+ *
+ * @return bigint& a reference owned by this object alone
+ */
+inline bigint &shared_bigint::mutate()
+{
+    if (number.use_count() > 1)
+    {
+        number = std::make_shared<bigint>(*number);
+    }
+    else
+    {
+        std::atomic_thread_fence(std::memory_order_acquire);
+    }
+    return const_cast<bigint &>(*number); // created non-const by make_shared, only held as const
+}
+
+/**
+ * @brief the number of shared_bigint objects sharing the number
+ *
+ * @return long the reference count
+ */
+inline long shared_bigint::use_count() const
+{
+    return number.use_count();
+}
+
+/**
+ * @brief Overload the += operator, copying the number first only if it is shared
+ *
+ * @param other a view to be added
+ * @return shared_bigint& this object
+ */
+inline shared_bigint &shared_bigint::operator+=(bigint_view other)
+{
+    mutate() += other;
+    return *this;
+}
+
+/**
+ * @brief Overload the -= operator, copying the number first only if it is shared
+ *
+ * @param other a view to be subtracted
+ * @return shared_bigint& this object
+ */
+inline shared_bigint &shared_bigint::operator-=(bigint_view other)
+{
+    mutate() -= other;
+    return *this;
+}
+
+/**
+ * @brief Overload the *= operator
+ *
+ * The product is computed into a new number, which replaces this object's reference, so the
+ * old number is never copied.
+ *
+ * @param other a view to be multiplied
+ * @return shared_bigint& this object
+ */
+inline shared_bigint &shared_bigint::operator*=(bigint_view other)
+{
+    number = std::make_shared<bigint>(bigint_view(*number) * other);
+    return *this;
+}
+
+/**
+ * @brief Overload the /= operator for a native integer divisor, copying the number first only if it is shared
+ *
+ * @tparam T a native integer type
+ * @param num the divisor
+ * @return shared_bigint& this object
+ */
+template <bigint_native_integer T>
+shared_bigint &shared_bigint::operator/=(T num)
+{
+    mutate() /= num;
+    return *this;
+}
+
+/**
+ * @brief Overload the %= operator for a native integer divisor, replacing the number with the remainder
+ *
+ * @tparam T a native integer type
+ * @param num the divisor
+ * @return shared_bigint& this object
+ */
+template <bigint_native_integer T>
+shared_bigint &shared_bigint::operator%=(T num)
+{
+    number = std::make_shared<bigint>(*number % num);
+    return *this;
+}
+
+/**
+ * @brief Overload the - operator to negate the number
+ *
+ * @return shared_bigint a new shared number
+ */
+inline shared_bigint shared_bigint::operator-() const
+{
+    return shared_bigint(-bigint_view(*number));
+}
+
+/**
+ * @brief Overload the ++ operator, copying the number first only if it is shared
+ *
+ * @return shared_bigint& this object
+ */
+inline shared_bigint &shared_bigint::operator++()
+{
+    ++mutate();
+    return *this;
+}
+
+/**
+ * @brief Overload the -- operator, copying the number first only if it is shared
+ *
+ * @return shared_bigint& this object
+ */
+inline shared_bigint &shared_bigint::operator--()
+{
+    --mutate();
+    return *this;
+}
+
+/**
+ * @brief Overload the << operator to print a shared_bigint to an output stream
+ *
+ * @param os an output stream
+ * @param num a shared_bigint to be inserted
+ * @return std::ostream& the output stream
+ */
+inline std::ostream &operator<<(std::ostream &os, const shared_bigint &num)
+{
+    return os << num.value();
+}
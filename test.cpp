@@ -1,8 +1,18 @@
 #include <iostream>
 #include <random>
 #include <cassert>
+#include <sstream>
 #include <stdexcept>
 #include "bigint.hpp"
+#include "fixed_bigint.hpp"
+#include "radix_bigint.hpp"
+#include "bigint_prime.hpp"
+#include "rns_bigint.hpp"
+#include "shared_bigint.hpp"
+#include "bigint_batch.hpp"
+#include "bigint_tune.hpp"
+#include "bigint_parallel.hpp"
+#include "bigint_column.hpp"
 
 // global variables
 bigint pass = 0; // used to count the number of tests passed
@@ -562,6 +572,2539 @@ void large_number_test()
     }
 }
 
+/**
+ * @brief test bigint_view: views of bigints, sub-ranges of limbs and external limbs as operands
+ *
+ */
+void view_test()
+{
+    bigint a("2268949521066274848768"); // 123 * 2^64
+    bigint b("-987654321");
+
+    // a view behaves like the bigint it refers to
+    if (bigint_view(a) + bigint_view(b) == a + b && bigint_view(a) * b == a * b && a - bigint_view(b) == a - b)
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "View test failed: arithmetic on views differs from arithmetic on bigints" << std::endl;
+    }
+
+    // a = 123 * 2^64 + 0, so limb [1, 2) is 123 and limb [0, 1) is zero
+    bigint_view high = bigint_view(a).subview(1, 1);
+    bigint_view low = bigint_view(a).subview(0, 1);
+    if (high == bigint(123) && low == bigint(0) && high + -b == bigint(987654444))
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "View test failed: subview of " << a << " has the wrong value" << std::endl;
+    }
+
+    // limbs stored outside of a bigint, little endian with leading zeros
+    const bigint_limb external[] = {321, 0, 0};
+    bigint_view c(external, true);
+    if (c == bigint(-321) && c < bigint(-320) && -c > bigint(320) && bigint(c) == bigint(-321))
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "View test failed: external limbs compare wrong" << std::endl;
+    }
+
+    // compound assignment of a view, including a view of the same bigint
+    bigint d(1000);
+    d += bigint_view(a).subview(1, 1);
+    d -= -c;
+    d *= bigint_view(d).subview(0, 1);
+    if (d == bigint(1000 + 123 - 321) * bigint(1000 + 123 - 321))
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "View test failed: compound assignment of views gave " << d << std::endl;
+    }
+
+    // Output test results
+    if (fail == 0)
+    {
+        std::cout << "All view tests passed!" << std::endl;
+    }
+    else
+    {
+        std::cout << "Some view tests failed!" << std::endl;
+    }
+}
+
+/**
+ * @brief test fixed_bigint: constexpr arithmetic, wrapping and conversions to and from bigint
+ *
+ */
+void fixed_bigint_test()
+{
+    // arithmetic is evaluated at compile time
+    constexpr fixed_bigint<128> x(INT64_MAX);
+    constexpr fixed_bigint<128> square = x * x;
+    static_assert(square == fixed_bigint<128>("85070591730234615847396907784232501249"));
+    static_assert(square - x * x == 0 && -square < 0 && square + square > square);
+    static_assert(fixed_bigint<256>(-1) * fixed_bigint<256>(-1) == 1);
+
+    // random operands agree with bigint
+    int64_t num1 = random_number_generator();
+    int64_t num2 = random_number_generator();
+    int64_t num3 = random_number_generator();
+    fixed_bigint<256> a(num1), b(num2), c(num3);
+    if ((a * b - c).to_bigint() == bigint(num1) * bigint(num2) - bigint(num3) &&
+        (a < b) == (bigint(num1) < bigint(num2)))
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "fixed_bigint test failed: a * b - c != bigint(num1) * bigint(num2) - bigint(num3)" << std::endl;
+    }
+
+    // round trip through bigint, including the most negative value
+    std::string min_str = "-57896044618658097711785492504343953926634992332820282019728792003956564819968";
+    fixed_bigint<256> min(min_str);
+    if (fixed_bigint<256>(bigint(min_str)) == min && min.to_bigint() == bigint(min_str) && min - 1 > min)
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "fixed_bigint test failed: round trip of " << min << std::endl;
+    }
+
+    // values that do not fit are rejected
+    try
+    {
+        fixed_bigint<128> too_big(bigint("170141183460469231731687303715884105728")); // 2^127
+        fail++;
+        std::cout << "fixed_bigint overflow test failed: exception not thrown!" << std::endl;
+    }
+    catch (const std::overflow_error &e)
+    {
+        std::cerr << "Exception caught: " << e.what() << std::endl;
+        pass++;
+    }
+
+    // Output test results
+    if (fail == 0)
+    {
+        std::cout << "All fixed_bigint tests passed!" << std::endl;
+    }
+    else
+    {
+        std::cout << "Some fixed_bigint tests failed!" << std::endl;
+    }
+}
+
+/**
+ * @brief test the _big literal against the string constructor
+ *
+ */
+void literal_test()
+{
+    if (123456789012345678901234567890_big == bigint("123456789012345678901234567890") &&
+        -98'765'432'109'876'543'210_big == bigint("-98765432109876543210") &&
+        0_big == bigint() && 000_big == bigint(0) && 0042_big == bigint(42))
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "Literal test failed: _big literal differs from the string constructor" << std::endl;
+    }
+
+    // Output test results
+    if (fail == 0)
+    {
+        std::cout << "All literal tests passed!" << std::endl;
+    }
+    else
+    {
+        std::cout << "Some literal tests failed!" << std::endl;
+    }
+}
+
+/**
+ * @brief test the bitwise operators, shifts and bit counts, negative numbers as infinite two's complement
+ *
+ */
+void bitwise_test()
+{
+    bigint a("6277101735386680763835789423207666416102355444464034512895"); // 2^192 - 1, three all-ones limbs
+    bigint b("-18446744073709551621");                                     // -(2^64 + 5)
+    bigint c("-340282366920938463463374607431768211455");                  // -(2^128 - 1)
+    bigint d("27898229935051914162629742809576156488680946869333642735");  // 0x123456789abcdef0fedcba9876543210123456789abcdef
+
+    // and, or and xor with mixed signs and all-ones limbs
+    if ((a & b) == bigint("6277101735386680763835789423207666416083908700390324961275"))
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "Bitwise and test failed: a & b != 2^192 - 2^64 - 5 for a = " << a << ", b = " << b << std::endl;
+    }
+
+    if ((a | b) == -1)
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "Bitwise or test failed: a | b != -1 for a = " << a << ", b = " << b << std::endl;
+    }
+
+    if ((a ^ b) == bigint("-6277101735386680763835789423207666416083908700390324961276"))
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "Bitwise xor test failed: a ^ b gave " << (a ^ b) << " for a = " << a << ", b = " << b << std::endl;
+    }
+
+    if ((b & c) == c && (b | c) == bigint("-18446744073709551621") &&
+        (b ^ c) == bigint("340282366920938463444927863358058659834"))
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "Bitwise test of two negatives failed: b & c = " << (b & c) << ", b | c = " << (b | c)
+                  << ", b ^ c = " << (b ^ c) << " for b = " << b << ", c = " << c << std::endl;
+    }
+
+    if ((d & c) == bigint("27898229935051914141456617756717763206351444681812869121") &&
+        (d ^ b) == bigint("-27898229935051914162629742809576156470234202795624091116") && (d & bigint(0)) == 0 &&
+        (d | bigint(0)) == d && (d ^ d) == 0)
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "Bitwise test of mixed lengths failed: d & c = " << (d & c) << ", d ^ b = " << (d ^ b)
+                  << " for d = " << d << std::endl;
+    }
+
+    if (~a == bigint("-6277101735386680763835789423207666416102355444464034512896") && ~b == bigint("18446744073709551620") &&
+        ~bigint(0) == -1 && ~bigint(-1) == 0)
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "Bitwise not test failed: ~a = " << ~a << ", ~b = " << ~b << ", expected -a - 1 and -b - 1" << std::endl;
+    }
+
+    // shifts by nothing, across a limb boundary, by whole limbs and by several limbs
+    const size_t counts[] = {0, 63, 64, 65, 200};
+    const char *left[] = {
+        "27898229935051914162629742809576156488680946869333642735",
+        "257315753860702653330375313502025276584947445180760365570453293350392954880",
+        "514631507721405306660750627004050553169894890361520731140906586700785909760",
+        "1029263015442810613321501254008101106339789780723041462281813173401571819520",
+        "44830727050119940240964247263114837448978655173349545577208863039800580261138068314008032170072471656100099637903360"};
+    const char *right[] = {"27898229935051914162629742809576156488680946869333642735", "3024732150408341860230788468441777730",
+                           "1512366075204170930115394234220888865", "756183037602085465057697117110444432", "0"};
+    const char *negative_right[] = {"-27898229935051914162629742809576156488680946869333642735",
+                                    "-3024732150408341860230788468441777731", "-1512366075204170930115394234220888866",
+                                    "-756183037602085465057697117110444433", "-1"};
+    for (size_t i = 0; i < 5; i++)
+    {
+        size_t s = counts[i];
+        if ((d << s) == bigint(left[i]) && (-d << s) == -bigint(left[i]))
+        {
+            pass++;
+        }
+        else
+        {
+            fail++;
+            std::cout << "Left shift test failed: d << " << s << " = " << (d << s) << " for d = " << d << std::endl;
+        }
+
+        if ((d >> s) == bigint(right[i]))
+        {
+            pass++;
+        }
+        else
+        {
+            fail++;
+            std::cout << "Right shift test failed: d >> " << s << " = " << (d >> s) << " for d = " << d << std::endl;
+        }
+
+        if ((-d >> s) == bigint(negative_right[i]))
+        {
+            pass++;
+        }
+        else
+        {
+            fail++;
+            std::cout << "Negative right shift test failed: -d >> " << s << " = " << (-d >> s)
+                      << ", expected rounding towards negative infinity, for d = " << d << std::endl;
+        }
+    }
+
+    // the README's example, and exact shifts of negatives that must not round
+    if ((bigint(-5) >> 1) == -3 && (bigint(5) >> 1) == 2 && (bigint(-4) >> 1) == -2 && (bigint(-1) >> 100) == -1 &&
+        (bigint(0) >> 64) == 0 && ((bigint(1) << 128) >> 128) == 1 && (-(bigint(1) << 128) >> 64) == -(bigint(1) << 64))
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "Right shift rounding test failed: -5 >> 1 = " << (bigint(-5) >> 1) << ", expected -3" << std::endl;
+    }
+
+    // compound forms
+    bigint e = b;
+    e &= a;
+    bigint f = b;
+    f |= c;
+    bigint g = a;
+    g ^= b;
+    bigint h = -d;
+    h <<= 65;
+    h >>= 130;
+    if (e == (a & b) && f == (b | c) && g == (a ^ b) && h == (-d >> 65))
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "Bitwise assignment test failed: &= gave " << e << ", |= gave " << f << ", ^= gave " << g
+                  << ", <<= then >>= gave " << h << std::endl;
+    }
+
+    // bit counts of the magnitude, the same for a number and its negation
+    if (bigint(0).bit_length() == 0 && bigint(0).popcount() == 0 && bigint(0).countr_zero() == 0)
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "Bit count test failed: zero has bit_length " << bigint(0).bit_length() << ", popcount "
+                  << bigint(0).popcount() << ", countr_zero " << bigint(0).countr_zero() << std::endl;
+    }
+
+    if (b.bit_length() == 65 && b.popcount() == 3 && b.countr_zero() == 0 && c.bit_length() == 128 && c.popcount() == 128)
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "Bit count test failed: b = " << b << " has bit_length " << b.bit_length() << ", popcount "
+                  << b.popcount() << "; c = " << c << " has bit_length " << c.bit_length() << std::endl;
+    }
+
+    bigint power = -(bigint(1) << 130);
+    if (power.bit_length() == 131 && power.popcount() == 1 && power.countr_zero() == 130 && (-power).countr_zero() == 130 &&
+        a.bit_length() == 192 && a.popcount() == 192)
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "Bit count test failed: -2^130 has bit_length " << power.bit_length() << ", popcount "
+                  << power.popcount() << ", countr_zero " << power.countr_zero() << std::endl;
+    }
+
+    // Output test results
+    if (fail == 0)
+    {
+        std::cout << "All bitwise tests passed!" << std::endl;
+    }
+    else
+    {
+        std::cout << "Some bitwise tests failed!" << std::endl;
+    }
+}
+
+/**
+ * @brief test the native integer fast paths against the bigint operators and the built-in ones
+ *
+ */
+void native_test()
+{
+    std::mt19937_64 mt64(701);
+    std::uniform_int_distribution<int64_t> dis(INT64_MIN, INT64_MAX);
+    std::uniform_int_distribution<int32_t> small(-1000, 1000);
+    for (int i = 0; i < 200; i++)
+    {
+        bigint a = bigint(dis(mt64)) * bigint(dis(mt64)) + bigint(small(mt64));
+        int64_t n = i % 2 == 0 ? dis(mt64) : small(mt64);
+        if (n == 0)
+        {
+            n = 1;
+        }
+        bigint b(n);
+
+        if (a + n == a + b && a - n == a - b && n + a == b + a && n - a == b - a)
+        {
+            pass++;
+        }
+        else
+        {
+            fail++;
+            std::cout << "Native addition test failed: a +- n != a +- bigint(n) for a = " << a << ", n = " << n << std::endl;
+        }
+
+        if (a * n == a * b && n * a == b * a)
+        {
+            pass++;
+        }
+        else
+        {
+            fail++;
+            std::cout << "Native multiplication test failed: a * n != a * bigint(n) for a = " << a << ", n = " << n << std::endl;
+        }
+
+        bigint quotient = a / n;
+        bigint remainder = a % n;
+        if (quotient * b + remainder == a && (remainder == 0 || (remainder < 0) == (a < 0)) &&
+            (remainder < 0 ? -remainder : remainder) < (b < 0 ? -b : b))
+        {
+            pass++;
+        }
+        else
+        {
+            fail++;
+            std::cout << "Native division test failed: a / n = " << quotient << ", a % n = " << remainder
+                      << " do not truncate for a = " << a << ", n = " << n << std::endl;
+        }
+    }
+
+    // small values follow the built-in operators, including truncation towards zero
+    for (int64_t x = -20; x <= 20; x++)
+    {
+        for (int64_t y : {-7, -2, -1, 1, 3, 10})
+        {
+            if (bigint(x) / y == bigint(x / y) && bigint(x) % y == bigint(x % y) && bigint(x) * y == bigint(x * y) &&
+                bigint(x) - y == bigint(x - y))
+            {
+                pass++;
+            }
+            else
+            {
+                fail++;
+                std::cout << "Native small value test failed: bigint operators differ from the built-in ones for x = " << x
+                          << ", y = " << y << std::endl;
+            }
+        }
+    }
+
+    // unsigned operands and the extremes of int64_t
+    bigint max_limb = bigint(INT64_MAX) * 2 + 1; // 2^64 - 1
+    if (bigint(0) + UINT64_MAX == max_limb && max_limb - UINT64_MAX == 0 && bigint(1) - UINT64_MAX == -max_limb + 1 &&
+        max_limb + 1u == bigint(1) << 64)
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "Native unsigned test failed: adding or subtracting UINT64_MAX, 0 + UINT64_MAX = " << bigint(0) + UINT64_MAX
+                  << std::endl;
+    }
+
+    if (bigint(5) * INT64_MIN == bigint(INT64_MIN) * bigint(5) && (bigint(1) << 64) / UINT64_MAX == 1 &&
+        bigint(INT64_MIN) / -1 == -bigint(INT64_MIN) && bigint(-7) % 2u == -1)
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "Native extremes test failed: 5 * INT64_MIN = " << bigint(5) * INT64_MIN << ", INT64_MIN / -1 = "
+                  << bigint(INT64_MIN) / -1 << ", -7 % 2u = " << bigint(-7) % 2u << std::endl;
+    }
+
+    // increment and decrement carry across limbs and change sign
+    bigint c = max_limb;
+    ++c;
+    bigint d = c;
+    --d;
+    if (c == bigint(1) << 64 && d == max_limb)
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "Increment test failed: ++(2^64 - 1) = " << c << ", then -- gave " << d << std::endl;
+    }
+
+    bigint up = -1;
+    ++up;
+    bigint down = 0;
+    --down;
+    if (up == 0 && down == -1 && --down == -2 && ++(++down) == 0)
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "Increment sign change test failed: ++(-1) = " << up << ", --0 then -- and ++ twice gave " << down << std::endl;
+    }
+
+    try
+    {
+        bigint(1) / 0;
+        fail++;
+        std::cout << "Native division by zero test failed: exception not thrown!" << std::endl;
+    }
+    catch (const std::domain_error &e)
+    {
+        std::cerr << "Exception caught: " << e.what() << std::endl;
+        pass++;
+    }
+
+    // Output test results
+    if (fail == 0)
+    {
+        std::cout << "All native integer tests passed!" << std::endl;
+    }
+    else
+    {
+        std::cout << "Some native integer tests failed!" << std::endl;
+    }
+}
+
+/**
+ * @brief test pow against repeated multiplication
+ *
+ */
+void pow_test()
+{
+    std::mt19937_64 mt64(33);
+    for (int i = 0; i < 40; i++)
+    {
+        bigint base = bigint(int64_t(mt64())) * bigint(int64_t(mt64() % 1000)) << size_t(mt64() % 70);
+        uint64_t exp = mt64() % 40;
+        bigint expected = 1;
+        for (uint64_t j = 0; j < exp; j++)
+        {
+            expected *= bigint(base);
+        }
+        if (pow(base, exp) == expected)
+        {
+            pass++;
+        }
+        else
+        {
+            fail++;
+            std::cout << "Power test failed: pow(base, " << exp << ") differs from repeated multiplication for base = " << base
+                      << std::endl;
+        }
+
+        if (base * base == base * bigint(base))
+        {
+            pass++;
+        }
+        else
+        {
+            fail++;
+            std::cout << "Square test failed: base * base != base * copy for base = " << base << std::endl;
+        }
+
+        // views of the same limbs with opposite signs are not a square
+        bigint_view view(base);
+        if (view * -view == -(base * bigint(base)) && -view * view == view * -view && -view * -view == base * base)
+        {
+            pass++;
+        }
+        else
+        {
+            fail++;
+            std::cout << "Square sign test failed: v * -v = " << view * -view << " for v = " << base << std::endl;
+        }
+    }
+
+    // powers of two and ten, the sign, and an exponent long enough for 4-bit windows
+    if (pow(bigint(2), 100) == bigint(1) << 100 && pow(bigint(-2), 3) == -8 &&
+        pow(bigint(-10), 21) == bigint("-1000000000000000000000"))
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "Power test failed: pow(2, 100) = " << pow(bigint(2), 100) << ", pow(-2, 3) = " << pow(bigint(-2), 3)
+                  << ", pow(-10, 21) = " << pow(bigint(-10), 21) << std::endl;
+    }
+
+    if (pow(bigint(0), 0) == 1 && pow(bigint(0), 5) == 0 && pow(bigint(-1), 1ull << 40) == 1)
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "Power edge case test failed: pow(0, 0) = " << pow(bigint(0), 0) << ", pow(0, 5) = " << pow(bigint(0), 5)
+                  << ", pow(-1, 2^40) = " << pow(bigint(-1), 1ull << 40) << std::endl;
+    }
+
+    if (pow(bigint(-3), 70001) % 1000000007 == -545625702)
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "Power window test failed: pow(-3, 70001) % 1000000007 = " << pow(bigint(-3), 70001) % 1000000007
+                  << ", expected -545625702" << std::endl;
+    }
+
+    // Output test results
+    if (fail == 0)
+    {
+        std::cout << "All power tests passed!" << std::endl;
+    }
+    else
+    {
+        std::cout << "Some power tests failed!" << std::endl;
+    }
+}
+
+/**
+ * @brief a radix policy that is neither binary nor decimal, to test general-base parsing
+ *
+ */
+struct base_1000_radix
+{
+    static constexpr bigint_double_limb base = 1000; // limb base
+    static constexpr size_t decimal_digits = 0;      // read as a general base, not 3 digits per limb
+};
+
+/**
+ * @brief a radix policy whose decimal_digits does not match its base
+ *
+ */
+struct mismatched_radix
+{
+    static constexpr bigint_double_limb base = 1000; // limb base
+    static constexpr size_t decimal_digits = 4;      // 10^4 is not the base
+};
+
+static_assert(bigint_radix<base_1000_radix> && !bigint_radix<mismatched_radix>);
+
+/**
+ * @brief test radix_bigint with decimal and binary limbs against bigint
+ *
+ */
+void radix_test()
+{
+    std::mt19937_64 mt64(34);
+    for (int i = 0; i < 100; i++)
+    {
+        bigint a = bigint(int64_t(mt64())) * bigint(int64_t(mt64())) * bigint(int64_t(mt64() % 100000));
+        bigint b = i % 5 == 0 ? -a : bigint(int64_t(mt64())) * bigint(int64_t(mt64() % 1000));
+        decimal_bigint x(a);
+        decimal_bigint y(b);
+        radix_bigint<decimal_radix<4>> u(a);
+        radix_bigint<binary_radix> v(a);
+        std::ostringstream expected, printed_x, printed_u, printed_v;
+        expected << a;
+        printed_x << x;
+        printed_u << u;
+        printed_v << v;
+        if (printed_x.str() == expected.str() && printed_u.str() == expected.str() && printed_v.str() == expected.str() &&
+            decimal_bigint(expected.str()) == x)
+        {
+            pass++;
+        }
+        else
+        {
+            fail++;
+            std::cout << "Radix printing test failed: " << printed_x.str() << ", " << printed_u.str() << " and "
+                      << printed_v.str() << " for a = " << a << std::endl;
+        }
+
+        if (u.to_bigint() == a && v.to_bigint() == a)
+        {
+            pass++;
+        }
+        else
+        {
+            fail++;
+            std::cout << "Radix conversion test failed: round trip through base 10^4 or 2^64 of a = " << a << std::endl;
+        }
+
+        if ((x + y).to_bigint() == a + b && (x - y).to_bigint() == a - b && (x * y).to_bigint() == a * b)
+        {
+            pass++;
+        }
+        else
+        {
+            fail++;
+            std::cout << "Radix arithmetic test failed: x + y = " << x + y << ", x - y = " << x - y << ", x * y = " << x * y
+                      << " for a = " << a << ", b = " << b << std::endl;
+        }
+
+        if ((x < y) == (a < b) && (x == y) == (a == b))
+        {
+            pass++;
+        }
+        else
+        {
+            fail++;
+            std::cout << "Radix comparison test failed: for a = " << a << ", b = " << b << std::endl;
+        }
+    }
+
+    // carries across whole limbs of nines, and signs
+    decimal_bigint nines("-99999999999999999999999999999999999999");
+    decimal_bigint next = nines;
+    --next;
+    std::ostringstream printed;
+    printed << next << ' ' << ++(-nines) << ' ' << decimal_bigint(-1) + 1 << ' ' << decimal_bigint("-0000");
+    if (printed.str() == "-100000000000000000000000000000000000000 100000000000000000000000000000000000000 0 0")
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "Radix carry test failed: printed " << printed.str() << std::endl;
+    }
+
+    // a base that is neither 2^64 nor a power of 10 parsed 19 digits at a time
+    std::string digits = "-123456789012345678901234567890";
+    bigint expected_thousands(digits);
+    radix_bigint<base_1000_radix> thousands(digits), converted(expected_thousands);
+    std::ostringstream printed_thousands;
+    printed_thousands << thousands;
+    if (printed_thousands.str() == digits && thousands.to_bigint() == expected_thousands && thousands == converted)
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "Radix general base test failed: " << digits << " in base 1000 printed as " << printed_thousands.str()
+                  << ", converted to " << thousands.to_bigint() << std::endl;
+    }
+
+    // Output test results
+    if (fail == 0)
+    {
+        std::cout << "All radix tests passed!" << std::endl;
+    }
+    else
+    {
+        std::cout << "Some radix tests failed!" << std::endl;
+    }
+}
+
+/**
+ * @brief test random_bigint, Montgomery arithmetic, is_probable_prime and next_prime
+ *
+ */
+void prime_test()
+{
+    std::mt19937_64 mt64(35);
+
+    // every number below 10000 against trial division
+    for (int64_t n = -3; n < 10000; n++)
+    {
+        bool prime = n >= 2;
+        for (int64_t d = 2; d * d <= n && prime; d++)
+        {
+            prime = n % d != 0;
+        }
+        if (is_probable_prime(bigint(n)) == prime)
+        {
+            pass++;
+        }
+        else
+        {
+            fail++;
+            std::cout << "Primality test failed: is_probable_prime(" << n << ") != " << prime << std::endl;
+        }
+    }
+
+    // Montgomery products against 128-bit arithmetic for one-limb moduli
+    auto from_limb = [](bigint_limb x)
+    { return bigint(bigint_view(std::span<const bigint_limb>(&x, 1))); };
+    for (int i = 0; i < 100; i++)
+    {
+        bigint_limb n = mt64() | 1;
+        bigint_limb a = mt64() % n;
+        bigint_limb b = mt64() % n;
+        bigint_montgomery mont(from_limb(n));
+        bigint product = mont.from_montgomery(mont.multiply(mont.to_montgomery(from_limb(a)), mont.to_montgomery(from_limb(b))));
+        if (product == from_limb(bigint_limb(bigint_double_limb(a) * b % n)))
+        {
+            pass++;
+        }
+        else
+        {
+            fail++;
+            std::cout << "Montgomery test failed: " << a << " * " << b << " mod " << n << " gave " << product << std::endl;
+        }
+    }
+
+    // Mersenne numbers, a strong pseudoprime to the bases 2, 3, 5 and 7, and a square
+    bigint mersenne = pow(bigint(2), 89) - 1;
+    if (is_probable_prime(mersenne) && is_probable_prime(pow(bigint(2), 521) - 1))
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "Primality test failed: 2^89 - 1 or 2^521 - 1 reported composite" << std::endl;
+    }
+
+    if (!is_probable_prime(pow(bigint(2), 128) + 1) && !is_probable_prime(bigint("3215031751")) &&
+        !is_probable_prime(mersenne * mersenne))
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "Primality test failed: 2^128 + 1, 3215031751 or (2^89 - 1)^2 reported prime" << std::endl;
+    }
+
+    if (next_prime(bigint("100000000000000000000")) == bigint("100000000000000000039") && next_prime(bigint(-5)) == 2 &&
+        next_prime(bigint(2)) == 3 && next_prime(bigint(7919)) == 7927)
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "Next prime test failed: next_prime(10^20) = " << next_prime(bigint("100000000000000000000"))
+                  << ", next_prime(-5) = " << next_prime(bigint(-5)) << ", next_prime(7919) = " << next_prime(bigint(7919))
+                  << std::endl;
+    }
+
+    for (int i = 0; i < 20; i++)
+    {
+        size_t bits = mt64() % 200;
+        bigint value = random_bigint(bits, mt64);
+        if (value.bit_length() <= bits && value >= 0)
+        {
+            pass++;
+        }
+        else
+        {
+            fail++;
+            std::cout << "Random number test failed: random_bigint(" << bits << ") gave " << value << std::endl;
+        }
+    }
+
+    // Output test results
+    if (fail == 0)
+    {
+        std::cout << "All prime tests passed!" << std::endl;
+    }
+    else
+    {
+        std::cout << "Some prime tests failed!" << std::endl;
+    }
+}
+
+/**
+ * @brief test long multiplication against a sum of single-limb products for many operand shapes
+ *
+ */
+void multiplication_test()
+{
+    std::mt19937_64 mt64(36);
+    for (size_t n = 1; n <= 12; n++)
+    {
+        for (size_t m = 1; m <= 12; m++)
+        {
+            // all-ones limbs give the largest column sums
+            bigint a = m % 3 == 0 ? (bigint(1) << (64 * n)) - 1 : random_bigint(64 * n, mt64) | bigint(1) << (64 * n - 1);
+            bigint b = n % 4 == 0 ? -((bigint(1) << (64 * m)) - 1) : random_bigint(64 * m, mt64) | bigint(1) << (64 * m - 1);
+            bigint expected;
+            bigint_view limbs(b);
+            for (size_t i = 0; i < limbs.size(); i++)
+            {
+                expected += (a * limbs[i]) << (64 * i);
+            }
+            if (b < 0)
+            {
+                expected = -expected;
+            }
+            if (a * b == expected && b * a == expected)
+            {
+                pass++;
+            }
+            else
+            {
+                fail++;
+                std::cout << "Multiplication test failed: " << n << " by " << m << " limbs, a * b = " << a * b
+                          << " differs from single-limb products " << expected << " for a = " << a << ", b = " << b << std::endl;
+            }
+        }
+    }
+
+    // Output test results
+    if (fail == 0)
+    {
+        std::cout << "All multiplication tests passed!" << std::endl;
+    }
+    else
+    {
+        std::cout << "Some multiplication tests failed!" << std::endl;
+    }
+}
+
+/**
+ * @brief test fma and fms against the product and the sum, including operands that alias the accumulator
+ *
+ */
+void fma_test()
+{
+    std::mt19937_64 mt64(37);
+    for (int i = 0; i < 300; i++)
+    {
+        bigint acc = random_bigint(mt64() % 300, mt64);
+        bigint a = random_bigint(mt64() % 300, mt64);
+        bigint b = random_bigint(mt64() % 300, mt64);
+        if (i % 2 == 0)
+        {
+            a = -a;
+        }
+        if (i % 3 == 0)
+        {
+            acc = i % 4 == 0 ? -acc : a * b + i % 5 - 2; // results that cross zero
+        }
+        bigint sum = acc;
+        bigint difference = acc;
+        bigint square = acc;
+        fma(sum, a, b);
+        fms(difference, a, b);
+        fma(square, square, square);
+        if (sum == acc + a * b)
+        {
+            pass++;
+        }
+        else
+        {
+            fail++;
+            std::cout << "fma test failed: fma gave " << sum << " for acc = " << acc << ", a = " << a << ", b = " << b << std::endl;
+        }
+
+        if (difference == acc - a * b)
+        {
+            pass++;
+        }
+        else
+        {
+            fail++;
+            std::cout << "fms test failed: fms gave " << difference << " for acc = " << acc << ", a = " << a << ", b = " << b
+                      << std::endl;
+        }
+
+        if (square == acc + acc * acc)
+        {
+            pass++;
+        }
+        else
+        {
+            fail++;
+            std::cout << "Aliased fma test failed: fma(acc, acc, acc) gave " << square << " for acc = " << acc << std::endl;
+        }
+    }
+
+    // Output test results
+    if (fail == 0)
+    {
+        std::cout << "All fused multiply-add tests passed!" << std::endl;
+    }
+    else
+    {
+        std::cout << "Some fused multiply-add tests failed!" << std::endl;
+    }
+}
+
+/**
+ * @brief test rns_bigint arithmetic and its conversions against bigint
+ *
+ */
+void rns_test()
+{
+    std::mt19937_64 mt64(38);
+    rns_basis basis = rns_basis::with_capacity(1024);
+    if (basis.product().bit_length() > 1025)
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "RNS basis test failed: the product of a basis for 1024 bits has only " << basis.product().bit_length()
+                  << " bits" << std::endl;
+    }
+
+    for (int i = 0; i < 100; i++)
+    {
+        bigint a = random_bigint(mt64() % 500 + 1, mt64);
+        bigint b = random_bigint(mt64() % 500 + 1, mt64);
+        bigint c = i % 3 == 0 ? -random_bigint(64, mt64) : random_bigint(64, mt64);
+        if (i % 2 == 0)
+        {
+            a = -a;
+        }
+        rns_bigint x(a, basis);
+        rns_bigint y(b, basis);
+        rns_bigint z(c, basis);
+        if (x.to_bigint() == a && (-x).to_bigint() == -a)
+        {
+            pass++;
+        }
+        else
+        {
+            fail++;
+            std::cout << "RNS conversion test failed: round trip gave " << x.to_bigint() << " for a = " << a << std::endl;
+        }
+
+        if ((x * y + z).to_bigint() == a * b + c)
+        {
+            pass++;
+        }
+        else
+        {
+            fail++;
+            std::cout << "RNS arithmetic test failed: x * y + z gave " << (x * y + z).to_bigint() << " for a = " << a
+                      << ", b = " << b << ", c = " << c << std::endl;
+        }
+
+        if ((x - y * z).to_bigint() == a - b * c)
+        {
+            pass++;
+        }
+        else
+        {
+            fail++;
+            std::cout << "RNS arithmetic test failed: x - y * z gave " << (x - y * z).to_bigint() << " for a = " << a
+                      << ", b = " << b << ", c = " << c << std::endl;
+        }
+
+        if ((x == y) == (a == b))
+        {
+            pass++;
+        }
+        else
+        {
+            fail++;
+            std::cout << "RNS comparison test failed: for a = " << a << ", b = " << b << std::endl;
+        }
+    }
+
+    // every value of a small basis round-trips, including both ends of (-M/2, M/2]
+    rns_basis small({3, 5, 7});
+    for (int64_t v = -52; v <= 52; v++)
+    {
+        if (rns_bigint(bigint(v), small).to_bigint() == bigint(v))
+        {
+            pass++;
+        }
+        else
+        {
+            fail++;
+            std::cout << "RNS small basis test failed: " << v << " converted back to "
+                      << rns_bigint(bigint(v), small).to_bigint() << std::endl;
+        }
+    }
+
+    if (rns_bigint(bigint(53), small).to_bigint() == bigint(-52))
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "RNS wrap test failed: 53 mod 105 converted back to " << rns_bigint(bigint(53), small).to_bigint()
+                  << ", expected -52" << std::endl;
+    }
+
+    try
+    {
+        rns_basis shared_factor({15, 21});
+        fail++;
+        std::cout << "RNS basis test failed: exception not thrown for moduli with a common factor!" << std::endl;
+    }
+    catch (const std::invalid_argument &e)
+    {
+        std::cerr << "Exception caught: " << e.what() << std::endl;
+        pass++;
+    }
+
+    // Output test results
+    if (fail == 0)
+    {
+        std::cout << "All RNS tests passed!" << std::endl;
+    }
+    else
+    {
+        std::cout << "Some RNS tests failed!" << std::endl;
+    }
+}
+
+/**
+ * @brief test the decimal digit kernels and the string round trip that uses them
+ *
+ */
+void digits_test()
+{
+    std::mt19937_64 mt64(39);
+    char buffer[19];
+    for (int i = 0; i < 10000; i++)
+    {
+        uint64_t value = mt64() % 10000000000000000000ULL >> (mt64() % 64);
+        bigint_format_19_digits(value, buffer);
+        std::string expected = std::to_string(value);
+        expected.insert(0, 19 - expected.size(), '0');
+        if (std::string(buffer, 19) == expected)
+        {
+            pass++;
+        }
+        else
+        {
+            fail++;
+            std::cout << "Digit format test failed: " << value << " formatted as " << std::string(buffer, 19) << std::endl;
+        }
+
+        size_t n = mt64() % 20;
+        uint64_t parsed = bigint_parse_digits(buffer + 19 - n, n);
+        if (parsed == (n == 0 ? 0 : std::stoull(expected.substr(19 - n))))
+        {
+            pass++;
+        }
+        else
+        {
+            fail++;
+            std::cout << "Digit parse test failed: the last " << n << " digits of " << expected << " parsed as " << parsed
+                      << std::endl;
+        }
+    }
+
+    // a bad character at every position of a string long enough for every vector width
+    std::string digits(100, '0');
+    for (size_t i = 0; i < digits.size(); i++)
+    {
+        digits[i] = char('0' + mt64() % 10);
+    }
+    if (bigint_all_digits(digits.data(), digits.size()))
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "Digit check test failed: " << digits << " rejected" << std::endl;
+    }
+
+    for (size_t i = 0; i < digits.size(); i++)
+    {
+        for (char bad : {'/', ':', ' ', '\0', char(0xB0)})
+        {
+            std::string corrupted = digits;
+            corrupted[i] = bad;
+            if (!bigint_all_digits(corrupted.data(), corrupted.size()))
+            {
+                pass++;
+            }
+            else
+            {
+                fail++;
+                std::cout << "Digit check test failed: character " << int(static_cast<unsigned char>(bad)) << " at position "
+                          << i << " accepted" << std::endl;
+            }
+        }
+    }
+
+    std::ostringstream printed;
+    printed << bigint("-" + digits) << ' ' << bigint("000000000000000000000000000000000000000000") << ' '
+            << bigint("-0000000000000000000010000000000000000000");
+    std::string trimmed = digits.substr(std::min(digits.find_first_not_of('0'), digits.size() - 1));
+    if (printed.str() == "-" + trimmed + " 0 -10000000000000000000")
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "Leading zero test failed: printed " << printed.str() << std::endl;
+    }
+
+    // Output test results
+    if (fail == 0)
+    {
+        std::cout << "All digit kernel tests passed!" << std::endl;
+    }
+    else
+    {
+        std::cout << "Some digit kernel tests failed!" << std::endl;
+    }
+}
+
+/**
+ * @brief test that the kernels chosen for this CPU agree with the portable ones
+ *
+ */
+void kernels_test()
+{
+    std::mt19937_64 mt64(40);
+    const bigint_kernels generic = bigint_kernels::select(bigint_cpu_features{});
+    const bigint_kernels &active = bigint_active_kernels;
+    for (int i = 0; i < 2000; i++)
+    {
+        size_t n = mt64() % 40 + 1;
+        size_t m = mt64() % 40 + 1;
+        std::vector<bigint_limb> a(n), b(n), c(m), out(n);
+        for (std::vector<bigint_limb> *limbs : {&a, &b, &c, &out})
+        {
+            for (bigint_limb &limb : *limbs)
+            {
+                limb = i % 4 == 0 ? ~bigint_limb(0) : mt64(); // all ones stresses every carry
+            }
+        }
+        bigint_limb multiplier = i % 4 == 0 ? ~bigint_limb(0) : mt64();
+
+        std::vector<bigint_limb> expected(n), actual(n);
+        if (generic.add_n(expected.data(), a.data(), b.data(), n) == active.add_n(actual.data(), a.data(), b.data(), n) &&
+            expected == actual)
+        {
+            pass++;
+        }
+        else
+        {
+            fail++;
+            std::cout << "Kernel test failed: " << active.name << " add_n differs from generic for a = " << bigint(bigint_view(a))
+                      << ", b = " << bigint(bigint_view(b)) << std::endl;
+        }
+
+        if (generic.sub_n(expected.data(), a.data(), b.data(), n) == active.sub_n(actual.data(), a.data(), b.data(), n) &&
+            expected == actual)
+        {
+            pass++;
+        }
+        else
+        {
+            fail++;
+            std::cout << "Kernel test failed: " << active.name << " sub_n differs from generic for a = " << bigint(bigint_view(a))
+                      << ", b = " << bigint(bigint_view(b)) << std::endl;
+        }
+
+        expected = actual = out;
+        if (generic.addmul_1(expected.data(), a.data(), n, multiplier) == active.addmul_1(actual.data(), a.data(), n, multiplier) &&
+            expected == actual)
+        {
+            pass++;
+        }
+        else
+        {
+            fail++;
+            std::cout << "Kernel test failed: " << active.name << " addmul_1 differs from generic for a = "
+                      << bigint(bigint_view(a)) << ", m = " << multiplier << std::endl;
+        }
+
+        if (generic.submul_1(expected.data(), a.data(), n, multiplier) == active.submul_1(actual.data(), a.data(), n, multiplier) &&
+            expected == actual)
+        {
+            pass++;
+        }
+        else
+        {
+            fail++;
+            std::cout << "Kernel test failed: " << active.name << " submul_1 differs from generic for a = "
+                      << bigint(bigint_view(a)) << ", m = " << multiplier << std::endl;
+        }
+
+        expected.assign(n + m, 0);
+        actual.assign(n + m, 0);
+        generic.mul_basecase(expected.data(), a.data(), n, c.data(), m);
+        active.mul_basecase(actual.data(), a.data(), n, c.data(), m);
+        if (expected == actual)
+        {
+            pass++;
+        }
+        else
+        {
+            fail++;
+            std::cout << "Kernel test failed: " << active.name << " mul_basecase differs from generic for a = "
+                      << bigint(bigint_view(a)) << ", c = " << bigint(bigint_view(c)) << std::endl;
+        }
+    }
+
+    std::string digits(100, '7');
+    if (active.all_digits(digits.data(), digits.size()))
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "Kernel test failed: " << active.name << " all_digits rejected 100 sevens" << std::endl;
+    }
+
+    digits[70] = ':';
+    if (!active.all_digits(digits.data(), digits.size()) && !generic.all_digits(digits.data(), digits.size()))
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "Kernel test failed: all_digits accepted a ':' at position 70" << std::endl;
+    }
+
+    // Output test results
+    if (fail == 0)
+    {
+        std::cout << "All kernel dispatch tests passed!" << std::endl;
+    }
+    else
+    {
+        std::cout << "Some kernel dispatch tests failed!" << std::endl;
+    }
+}
+
+/**
+ * @brief test that shared_bigint copies share limbs and that mutation copies them first
+ *
+ */
+void shared_test()
+{
+    shared_bigint a("-123456789012345678901234567890123456789");
+    shared_bigint b = a;
+    if (a.use_count() == 2 && bigint_view(a).limbs().data() == bigint_view(b).limbs().data())
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "Shared copy test failed: a copy has use_count " << a.use_count() << " or does not share the limbs"
+                  << std::endl;
+    }
+
+    // mutation separates b from a, and leaves a unchanged
+    ++b;
+    b *= a;
+    b /= 10;
+    if (a.use_count() == 1 && b.use_count() == 1 && a == bigint("-123456789012345678901234567890123456789"))
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "Copy on write test failed: after mutating b, a = " << a << " with use_count " << a.use_count() << std::endl;
+    }
+
+    if (b == bigint("1524157875323883675049535156256668194488187776861301630897378448410862673373"))
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "Shared mutation test failed: (a + 1) * a / 10 gave " << b << std::endl;
+    }
+
+    // a unique number is modified in place
+    const bigint_limb *limbs = bigint_view(a).limbs().data();
+    --a;
+    if (bigint_view(a).limbs().data() == limbs)
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "Shared in-place test failed: decrementing an unshared number copied it" << std::endl;
+    }
+
+    shared_bigint c = a;
+    c %= 1000;
+    std::ostringstream printed;
+    printed << c << ' ' << -c << ' ' << a + c;
+    if (printed.str() == "-790 790 -123456789012345678901234567890123457580")
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "Shared printing test failed: printed " << printed.str() << std::endl;
+    }
+
+    // Output test results
+    if (fail == 0)
+    {
+        std::cout << "All shared bigint tests passed!" << std::endl;
+    }
+    else
+    {
+        std::cout << "Some shared bigint tests failed!" << std::endl;
+    }
+}
+
+/**
+ * @brief test bigint division and gcd, then product trees, remainder trees and batch GCD
+ *
+ */
+void batch_test()
+{
+    // division on both sides of the recursive threshold, with every sign combination
+    std::mt19937_64 mt64(42);
+    for (size_t bits : {100u, 1000u, 4000u, 12000u, 40000u})
+    {
+        for (int signs = 0; signs < 4; signs++)
+        {
+            bigint a = random_bigint(2 * bits + 37, mt64) + 1;
+            bigint b = random_bigint(bits, mt64) + 1;
+            a = signs & 1 ? -a : a;
+            b = signs & 2 ? -b : b;
+            auto [q, r] = divmod(a, b);
+            if (q * b + r == a && (r < 0 ? -r : r) < (b < 0 ? -b : b) && (r == 0 || (r < 0) == (a < 0)))
+            {
+                pass++;
+            }
+            else
+            {
+                fail++;
+                std::cout << "Division test failed: divmod of " << 2 * bits + 37 << " by " << bits << " bits gave q = " << q
+                          << ", r = " << r << " for a = " << a << ", b = " << b << std::endl;
+            }
+
+            if (a / b == q && a % b == r && (a * b) / b == a)
+            {
+                pass++;
+            }
+            else
+            {
+                fail++;
+                std::cout << "Division test failed: / or % differs from divmod for a = " << a << ", b = " << b << std::endl;
+            }
+        }
+    }
+
+    try
+    {
+        bigint(1) / bigint(0);
+        fail++;
+        std::cout << "Division by zero test failed: exception not thrown!" << std::endl;
+    }
+    catch (const std::domain_error &e)
+    {
+        std::cerr << "Exception caught: " << e.what() << std::endl;
+        pass++;
+    }
+
+    bigint g = bigint("340282366920938463463374607431768211507"); // a prime above 2^128
+    if (gcd(g * 1000000007 * 6, -g * 1000000009 * 15) == g * 3 && gcd(g, bigint(0)) == g && gcd(bigint(0), bigint(0)) == 0)
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "GCD test failed: gcd(6 * 1000000007 * g, -15 * 1000000009 * g) = "
+                  << gcd(g * 1000000007 * 6, -g * 1000000009 * 15) << " for g = " << g << std::endl;
+    }
+
+    // remainder tree against one division per modulus
+    std::vector<bigint> moduli;
+    for (int i = 0; i < 13; i++)
+    {
+        moduli.push_back(random_bigint(300, mt64) + 2);
+    }
+    bigint_product_tree tree(moduli);
+    bigint product = 1;
+    for (const bigint &m : moduli)
+    {
+        product *= m;
+    }
+    bigint x = -random_bigint(5000, mt64);
+    std::vector<bigint> remainders = tree.remainders(x);
+    if (tree.size() == 13 && tree.product() == product && remainders.size() == 13)
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "Product tree test failed: size " << tree.size() << ", " << remainders.size()
+                  << " remainders, product " << tree.product() << " instead of " << product << std::endl;
+    }
+
+    if (bigint_product_tree({}).product() == 1 && bigint_product_tree({}).remainders(x).empty())
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "Empty product tree test failed: product " << bigint_product_tree({}).product() << ", "
+                  << bigint_product_tree({}).remainders(x).size() << " remainders" << std::endl;
+    }
+
+    for (size_t i = 0; i < moduli.size() && i < remainders.size(); i++)
+    {
+        if (remainders[i] == x % moduli[i])
+        {
+            pass++;
+        }
+        else
+        {
+            fail++;
+            std::cout << "Remainder tree test failed: x % m = " << remainders[i] << " instead of " << x % moduli[i]
+                      << " for m = " << moduli[i] << std::endl;
+        }
+    }
+
+    // moduli 0 and 2 share the prime 1000000007, the others share nothing
+    std::vector<bigint> rsa{bigint(1000000007) * 998244353, bigint(2147483647) * 4294967291, bigint(1000000007) * 1000000009,
+                            g * bigint("18446744073709551557")};
+    std::vector<bigint> shared = batch_gcd(rsa);
+    if (shared.size() == 4 && shared[0] == 1000000007 && shared[1] == 1 && shared[2] == 1000000007 && shared[3] == 1)
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "Batch GCD test failed: gave";
+        for (const bigint &factor : shared)
+        {
+            std::cout << ' ' << factor;
+        }
+        std::cout << ", expected 1000000007 1 1000000007 1" << std::endl;
+    }
+
+    if (batch_gcd({}).empty() && batch_gcd(std::vector<bigint>{rsa[0]})[0] == 1)
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "Batch GCD test failed: an empty or single-number batch found a shared factor" << std::endl;
+    }
+
+    // Output test results
+    if (fail == 0)
+    {
+        std::cout << "All batch tests passed!" << std::endl;
+    }
+    else
+    {
+        std::cout << "Some batch tests failed!" << std::endl;
+    }
+}
+
+/**
+ * @brief test that every threshold gives the same results, and loading, saving and tuning thresholds
+ *
+ */
+void thresholds_test()
+{
+    // results with the defaults, then with every algorithm recursing down to the minimum size
+    std::mt19937_64 mt64(44);
+    std::vector<bigint> numbers;
+    for (size_t bits : {300u, 2000u, 9000u, 30000u})
+    {
+        numbers.push_back(random_bigint(bits, mt64) + 1);
+    }
+    auto results = [&]()
+    {
+        std::ostringstream out;
+        for (size_t i = 0; i + 1 < numbers.size(); i++)
+        {
+            bigint product = numbers[i + 1] * -numbers[i];
+            auto [q, r] = divmod(numbers[i + 1] * numbers[i + 1] + 12345, numbers[i]);
+            out << product << ' ' << numbers[i] * numbers[i] << ' ' << q << ' ' << r << ' '
+                << bigint(-numbers[i + 1] * numbers[i]) - product << '\n';
+        }
+        return out.str();
+    };
+    bigint_thresholds saved = bigint_active_thresholds;
+    std::string expected = results();
+    size_t m = bigint_thresholds::minimum;
+    bigint_active_thresholds = {m, m, m, m};
+    std::string smallest = results();
+    bigint_active_thresholds = {0, 1, 0, 1}; // assigned directly, so raised to the minimum when read
+    std::string raised = results();
+    std::ostringstream digits;
+    digits << numbers.back();
+    bool round_trip = bigint(digits.str()) == numbers.back() && bigint("-" + digits.str()) == -numbers.back();
+    bigint_active_thresholds = saved;
+    if (smallest == expected)
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "Thresholds test failed: products, squares or quotients differ with every threshold at " << m << std::endl;
+    }
+
+    if (raised == expected)
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "Thresholds test failed: thresholds below the minimum were not raised to it" << std::endl;
+    }
+
+    if (round_trip)
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "Thresholds test failed: recursive conversion of a 30000-bit number did not round-trip" << std::endl;
+    }
+
+    // load what save writes, and reject thresholds that are too small or unknown
+    bigint_thresholds tuned{50, 90, 120, 70};
+    std::stringstream file;
+    file << "# measured on this machine\n\n";
+    tuned.save(file);
+    if (bigint_thresholds::load(file) == tuned)
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "Thresholds load test failed: loading what save wrote gave different thresholds:\n" << file.str() << std::endl;
+    }
+
+    std::istringstream partial("recursive_division 200\n");
+    bigint_thresholds defaults;
+    bigint_thresholds partial_loaded = bigint_thresholds::load(partial);
+    if (partial_loaded.recursive_division == 200 && partial_loaded.karatsuba == defaults.karatsuba)
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "Thresholds load test failed: a partial file gave recursive_division " << partial_loaded.recursive_division
+                  << " and karatsuba " << partial_loaded.karatsuba << std::endl;
+    }
+
+    for (const char *bad : {"karatsuba 2", "karatsuba", "karatsuba 40 50", "toom 40"})
+    {
+        try
+        {
+            std::istringstream line(bad);
+            bigint_thresholds::load(line);
+            fail++;
+            std::cout << "Thresholds load test failed: exception not thrown for \"" << bad << "\"!" << std::endl;
+        }
+        catch (const std::invalid_argument &e)
+        {
+            std::cerr << "Exception caught: " << e.what() << std::endl;
+            pass++;
+        }
+    }
+
+    std::ostringstream header;
+    tuned.save_header(header);
+    if (header.str().find("#define BIGINT_KARATSUBA_THRESHOLD 50\n") != std::string::npos)
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "Thresholds header test failed: wrote\n" << header.str() << std::endl;
+    }
+
+    // a short tuning run stays in range and leaves the active thresholds alone
+    bigint_tune_options options;
+    options.min_time = 0.0005;
+    options.max_limbs = 12;
+    bigint_thresholds measured = bigint_tune(options);
+    if (bigint_active_thresholds == saved)
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "Tuning test failed: bigint_tune changed the active thresholds" << std::endl;
+    }
+
+    for (size_t threshold : {measured.karatsuba, measured.karatsuba_square, measured.recursive_division, measured.recursive_conversion})
+    {
+        if (threshold >= 2 * bigint_thresholds::minimum && threshold <= options.max_limbs + 1)
+        {
+            pass++;
+        }
+        else
+        {
+            fail++;
+            std::cout << "Tuning test failed: measured threshold " << threshold << " is outside [" << 2 * bigint_thresholds::minimum
+                      << ", " << options.max_limbs + 1 << "]" << std::endl;
+        }
+    }
+
+    // Output test results
+    if (fail == 0)
+    {
+        std::cout << "All threshold tests passed!" << std::endl;
+    }
+    else
+    {
+        std::cout << "Some threshold tests failed!" << std::endl;
+    }
+}
+
+/**
+ * @brief test the size-specialised kernels against the general ones for every pair of small lengths
+ *
+ */
+void small_kernels_test()
+{
+    std::mt19937_64 mt64(45);
+    for (size_t n = 1; n <= bigint_small_limbs; n++)
+    {
+        for (size_t m = 1; m <= bigint_small_limbs; m++)
+        {
+            for (int round = 0; round < 4; round++)
+            {
+                // all-ones limbs carry through every position
+                std::vector<bigint_limb> a(n), b(bigint_small_limbs, 0);
+                for (size_t i = 0; i < n; i++)
+                {
+                    a[i] = round == 0 ? ~bigint_limb(0) : mt64();
+                }
+                for (size_t i = 0; i < m; i++)
+                {
+                    b[i] = round == 0 ? ~bigint_limb(0) : round == 1 ? a[std::min(i, n - 1)] : mt64();
+                }
+                bigint value_a{bigint_view(a)}, value_b{bigint_view(std::span<const bigint_limb>(b.data(), m))};
+
+                std::vector<bigint_limb> expected(n + m), actual(n + m);
+                bigint_mul_basecase_generic(expected.data(), a.data(), n, b.data(), m);
+                bigint_mul_small[n - 1][m - 1](actual.data(), a.data(), b.data());
+                if (expected == actual)
+                {
+                    pass++;
+                }
+                else
+                {
+                    fail++;
+                    std::cout << "Small kernel test failed: bigint_mul_fixed<" << n << ", " << m << "> differs for a = " << value_a
+                              << ", b = " << value_b << std::endl;
+                }
+
+                if (m <= n)
+                {
+                    std::vector<bigint_limb> padded(b.begin(), b.begin() + ptrdiff_t(n)), sum(n), difference(n);
+                    if (bigint_add_small[n - 1][m - 1](sum.data(), a.data(), b.data()) ==
+                            bigint_add_n_generic(expected.data(), a.data(), padded.data(), n) &&
+                        std::equal(sum.begin(), sum.end(), expected.begin()))
+                    {
+                        pass++;
+                    }
+                    else
+                    {
+                        fail++;
+                        std::cout << "Small kernel test failed: bigint_add_fixed<" << n << ", " << m << "> differs for a = "
+                                  << value_a << ", b = " << value_b << std::endl;
+                    }
+
+                    if (bigint_sub_small[n - 1][m - 1](difference.data(), a.data(), b.data()) ==
+                            bigint_sub_n_generic(expected.data(), a.data(), padded.data(), n) &&
+                        std::equal(difference.begin(), difference.end(), expected.begin()))
+                    {
+                        pass++;
+                    }
+                    else
+                    {
+                        fail++;
+                        std::cout << "Small kernel test failed: bigint_sub_fixed<" << n << ", " << m << "> differs for a = "
+                                  << value_a << ", b = " << value_b << std::endl;
+                    }
+                }
+                if (m == n)
+                {
+                    int order = std::lexicographical_compare(a.rbegin(), a.rend(), b.rend() - ptrdiff_t(n), b.rend())   ? -1
+                                : std::equal(a.begin(), a.end(), b.begin()) ? 0
+                                                                            : 1;
+                    if (bigint_cmp_small[n - 1](a.data(), b.data()) == order)
+                    {
+                        pass++;
+                    }
+                    else
+                    {
+                        fail++;
+                        std::cout << "Small kernel test failed: bigint_cmp_fixed<" << n << "> does not give " << order
+                                  << " for a = " << value_a << ", b = " << value_b << std::endl;
+                    }
+                }
+            }
+        }
+    }
+
+    // Output test results
+    if (fail == 0)
+    {
+        std::cout << "All small kernel tests passed!" << std::endl;
+    }
+    else
+    {
+        std::cout << "Some small kernel tests failed!" << std::endl;
+    }
+}
+
+/**
+ * @brief test hexadecimal, octal, binary and base 32 input and output
+ *
+ */
+void power_radix_test()
+{
+    bigint key = bigint::from_hex("-DEADbeef00112233445566778899");
+    if (key == bigint("-4516460495211091567017211098269849") && key.to_string(16) == "-deadbeef00112233445566778899")
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "Power radix test failed: from_hex(\"-DEADbeef00112233445566778899\") = " << key << ", to_string(16) = "
+                  << key.to_string(16) << std::endl;
+    }
+
+    for (auto [str, radix, expected] :
+         {std::tuple<const char *, unsigned, bigint>{"1011", 2, 11}, {"777", 8, 511}, {"vv", 32, 1023}, {"0003", 4, 3},
+          {"-12345678901234567890123", 10, bigint("-12345678901234567890123")}, {"-0", 16, 0}})
+    {
+        bigint parsed = bigint::from_string(str, radix);
+        if (parsed == expected)
+        {
+            pass++;
+        }
+        else
+        {
+            fail++;
+            std::cout << "Power radix test failed: from_string(\"" << str << "\", " << radix << ") = " << parsed << " instead of "
+                      << expected << std::endl;
+        }
+    }
+
+    if (bigint::from_hex("-0").to_string(16) == "0" && bigint().to_string(2) == "0")
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "Power radix test failed: zero is written as " << bigint::from_hex("-0").to_string(16) << " in base 16 and "
+                  << bigint().to_string(2) << " in base 2" << std::endl;
+    }
+
+    // every radix and length round trips, including digits that straddle two limbs
+    std::mt19937_64 mt64(46);
+    for (size_t bits : {1u, 63u, 64u, 65u, 128u, 190u, 191u, 192u, 1000u, 5000u})
+    {
+        bigint x = random_bigint(bits, mt64) * (bits % 2 == 0 ? -1 : 1);
+        for (unsigned radix : {2u, 4u, 8u, 10u, 16u, 32u})
+        {
+            std::string digits = x.to_string(radix);
+            if (bigint::from_string(digits, radix) == x && digits.find_first_of("ABCDEF") == std::string::npos)
+            {
+                pass++;
+            }
+            else
+            {
+                fail++;
+                std::cout << "Power radix test failed: " << x << " written in base " << radix << " as " << digits
+                          << " does not round-trip" << std::endl;
+            }
+        }
+        std::ostringstream decimal;
+        decimal << x;
+        if (x.to_string() == decimal.str())
+        {
+            pass++;
+        }
+        else
+        {
+            fail++;
+            std::cout << "Power radix test failed: to_string() = " << x.to_string() << " instead of " << decimal.str() << std::endl;
+        }
+    }
+
+    bigint pattern = bigint::from_hex("123456789abcdef0fedcba9876543210");
+    if (pattern.to_string(8) == "221505317046536336741773345651416625031020" && pattern.to_string(2).size() == 125)
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "Power radix test failed: 0x123456789abcdef0fedcba9876543210 is " << pattern.to_string(8) << " in octal and "
+                  << pattern.to_string(2) << " in binary" << std::endl;
+    }
+
+    for (auto [str, radix] : {std::pair<const char *, unsigned>{"12", 2}, {"8", 8}, {"0x1f", 16}, {"g", 16}, {"-", 16}, {"", 16}, {"1", 3}, {"1", 64}})
+    {
+        try
+        {
+            bigint::from_string(str, radix);
+            fail++;
+            std::cout << "Power radix test failed: exception not thrown for \"" << str << "\" in base " << radix << "!" << std::endl;
+        }
+        catch (const std::invalid_argument &e)
+        {
+            std::cerr << "Exception caught: " << e.what() << std::endl;
+            pass++;
+        }
+    }
+
+    // Output test results
+    if (fail == 0)
+    {
+        std::cout << "All power radix tests passed!" << std::endl;
+    }
+    else
+    {
+        std::cout << "Some power radix tests failed!" << std::endl;
+    }
+}
+
+/**
+ * @brief test parallel sums and products against serial ones, with several thread counts
+ *
+ */
+void parallel_test()
+{
+    // enough values that the sum is split across threads, with mixed signs and sizes
+    std::mt19937_64 mt64(46);
+    std::vector<bigint> values;
+    for (int i = 0; i < 20000; i++)
+    {
+        bigint value = random_bigint(1 + mt64() % 400, mt64);
+        values.push_back(i % 3 == 0 ? -value : value);
+    }
+    bigint sum = 0;
+    for (const bigint &value : values)
+    {
+        sum += value;
+    }
+    for (unsigned threads : {0u, 1u, 3u, 8u})
+    {
+        bigint parallel = parallel_sum(values.begin(), values.end(), threads);
+        if (parallel == sum)
+        {
+            pass++;
+        }
+        else
+        {
+            fail++;
+            std::cout << "Parallel sum test failed: " << threads << " threads gave " << parallel << " instead of " << sum << std::endl;
+        }
+    }
+
+    bigint_deferred_sum deferred;
+    deferred.add(bigint(-5));
+    deferred.add(bigint("340282366920938463463374607431768211455")); // 2^128 - 1
+    deferred.add(bigint(6));
+    if (deferred.value() == bigint("340282366920938463463374607431768211456"))
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "Deferred sum test failed: -5 + (2^128 - 1) + 6 = " << deferred.value() << std::endl;
+    }
+
+    if (bigint_deferred_sum().value() == 0 && parallel_sum(values.begin(), values.begin()) == 0)
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "Parallel sum test failed: an empty sum is " << bigint_deferred_sum().value() << " deferred and "
+                  << parallel_sum(values.begin(), values.begin()) << " in parallel" << std::endl;
+    }
+
+    // products of a range split into uneven parts, and a shared_bigint range
+    std::vector<bigint> factors(values.begin(), values.begin() + 1001);
+    bigint product = 1;
+    for (const bigint &factor : factors)
+    {
+        product *= factor;
+    }
+    for (unsigned threads : {0u, 1u, 3u, 8u})
+    {
+        bigint parallel = parallel_product(factors.begin(), factors.end(), threads);
+        if (parallel == product)
+        {
+            pass++;
+        }
+        else
+        {
+            fail++;
+            std::cout << "Parallel product test failed: " << threads << " threads gave " << parallel << " instead of " << product
+                      << std::endl;
+        }
+    }
+
+    std::vector<shared_bigint> shared{shared_bigint(bigint(-7)), shared_bigint(bigint(6)), shared_bigint(bigint(0))};
+    bigint shared_product = parallel_product(shared.begin(), shared.begin() + 2);
+    bigint zero_product = parallel_product(shared.begin(), shared.end());
+    bigint empty_product = parallel_product(factors.end(), factors.end());
+    if (shared_product == -42 && zero_product == 0 && empty_product == 1)
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "Parallel product test failed: -7 * 6 = " << shared_product << ", -7 * 6 * 0 = " << zero_product
+                  << ", empty product = " << empty_product << std::endl;
+    }
+
+    // Output test results
+    if (fail == 0)
+    {
+        std::cout << "All parallel tests passed!" << std::endl;
+    }
+    else
+    {
+        std::cout << "Some parallel tests failed!" << std::endl;
+    }
+}
+
+/**
+ * @brief test that the recursive algorithms reuse the scratch arena instead of allocating temporaries
+ *
+ */
+void scratch_test()
+{
+    // operands above every threshold, so Karatsuba, recursive division and conversion all run
+    std::mt19937_64 mt64(47);
+    bigint a = random_bigint(64 * 3000, mt64) + 1;
+    bigint b = random_bigint(64 * 1200, mt64) + 1;
+    bigint g = random_bigint(64 * 100, mt64) + 1;
+    bigint x = g * (random_bigint(64 * 150, mt64) * 2 + 1);
+    bigint y = g * (random_bigint(64 * 120, mt64) * 2);
+    bigint_scratch &scratch = bigint_scratch::local();
+    bigint product, square, q, r, parsed, common;
+    auto run = [&]()
+    {
+        product = a * b;
+        square = a * a;
+        std::tie(q, r) = divmod(product, b);
+        parsed = bigint(product.to_string());
+        common = gcd(x, y);
+    };
+
+    run();
+    size_t capacity = scratch.capacity();
+    bigint_stats_reset();
+    run();
+    bigint_stats stats = bigint_stats_snapshot();
+#ifdef BIGINT_INSTRUMENTATION
+    // only the results: the product, the square, the quotient and remainder, the parsed number and the GCD
+    size_t expected_allocations = 6;
+#else
+    size_t expected_allocations = 0; // compiled out
+#endif
+    if (stats.allocations == expected_allocations)
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "Scratch test failed: " << stats.allocations << " allocations after warm-up instead of "
+                  << expected_allocations << ", counters were:\n"
+                  << stats << std::endl;
+    }
+
+    if (q == a && r == 0 && square == a * bigint(a) && parsed == product)
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "Scratch test failed: a * b / b gave q = " << q << ", r = " << r << " for a = " << a << ", b = " << b
+                  << std::endl;
+    }
+
+    if (common % g == 0 && gcd(x / common, y / common) == 1)
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "Scratch test failed: gcd(x, y) = " << common << " for x = " << x << ", y = " << y << std::endl;
+    }
+
+    if (scratch.capacity() == capacity && scratch.block_count() == 1 && scratch.in_use() == 0)
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "Scratch test failed: the arena has capacity " << scratch.capacity() << " instead of " << capacity << ", "
+                  << scratch.block_count() << " blocks and " << scratch.in_use() << " limbs in use" << std::endl;
+    }
+
+    // Output test results
+    if (fail == 0)
+    {
+        std::cout << "All scratch tests passed!" << std::endl;
+    }
+    else
+    {
+        std::cout << "Some scratch tests failed!" << std::endl;
+    }
+}
+
+/**
+ * @brief test the packed column against vectors of bigints
+ *
+ */
+void column_test()
+{
+    // values of every size up to above the conversion threshold, with both signs and zeros
+    std::mt19937_64 mt64(48);
+    std::vector<bigint> values, others;
+    std::string text;
+    for (int i = 0; i < 300; i++)
+    {
+        size_t bits = i % 50 == 0 ? 64 * 120 : mt64() % 300;
+        bigint value = random_bigint(bits, mt64);
+        values.push_back(i % 3 == 0 ? -value : value);
+        others.push_back(i % 4 == 0 ? bigint(0) : random_bigint(mt64() % 200 + 1, mt64) - random_bigint(150, mt64));
+        text += values.back().to_string() + '\n';
+    }
+    bigint_column column = bigint_column::parse(text);
+    bigint_column other;
+    size_t limbs = 0;
+    for (size_t i = 0; i < values.size(); i++)
+    {
+        other.push_back(others[i]);
+        limbs += bigint_view(values[i]).size();
+    }
+    if (column.size() == values.size() && column.limb_count() == limbs)
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "Column test failed: " << column.size() << " values in " << column.limb_count() << " limbs instead of "
+                  << values.size() << " in " << limbs << std::endl;
+    }
+
+    if (column.format() + '\n' == text && bigint_column::parse(column.format(';'), ';') == column)
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "Column test failed: format() does not round-trip through parse(), wrote\n" << column.format() << std::endl;
+    }
+
+    if (bigint_column::parse("").empty() && bigint_column::parse("-0\r\n7\r\n").format(',') == "0,7")
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "Column test failed: parse(\"-0\\r\\n7\\r\\n\") is formatted as "
+                  << bigint_column::parse("-0\r\n7\r\n").format(',') << std::endl;
+    }
+
+    for (size_t i = 0; i < values.size() && i < column.size(); i++)
+    {
+        if (column[i] == values[i])
+        {
+            pass++;
+        }
+        else
+        {
+            fail++;
+            std::cout << "Column test failed: value " << i << " is " << bigint(column[i]) << " instead of " << values[i] << std::endl;
+        }
+    }
+
+    // element-wise arithmetic, with a column and with one number on the right
+    bigint scalar("-98765432109876543210987654321");
+    bigint_column sum = column + other, difference = column - other, product = column * other;
+    bigint_column shifted = column + scalar, lowered = column - scalar, scaled = column * scalar;
+    if (sum.size() == values.size() && scaled.size() == values.size())
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "Column arithmetic test failed: results have " << sum.size() << " and " << scaled.size()
+                  << " values instead of " << values.size() << std::endl;
+    }
+
+    for (size_t i = 0; i < values.size() && i < sum.size() && i < scaled.size(); i++)
+    {
+        if (sum[i] == values[i] + others[i] && difference[i] == values[i] - others[i] && product[i] == values[i] * others[i])
+        {
+            pass++;
+        }
+        else
+        {
+            fail++;
+            std::cout << "Column arithmetic test failed: value " << i << " gave sum " << bigint(sum[i]) << ", difference "
+                      << bigint(difference[i]) << ", product " << bigint(product[i]) << " for a = " << values[i] << ", b = " << others[i]
+                      << std::endl;
+        }
+
+        if (shifted[i] == values[i] + scalar && lowered[i] == values[i] - scalar && scaled[i] == values[i] * scalar)
+        {
+            pass++;
+        }
+        else
+        {
+            fail++;
+            std::cout << "Column arithmetic test failed: value " << i << " gave sum " << bigint(shifted[i]) << ", difference "
+                      << bigint(lowered[i]) << ", product " << bigint(scaled[i]) << " for a = " << values[i] << ", b = " << scalar << std::endl;
+        }
+    }
+
+    // sorting, and appending a value of the column itself
+    std::sort(values.begin(), values.end());
+    column.sort();
+    for (size_t i = 0; i < values.size() && i < column.size(); i++)
+    {
+        if (column[i] == values[i])
+        {
+            pass++;
+        }
+        else
+        {
+            fail++;
+            std::cout << "Column sort test failed: value " << i << " is " << bigint(column[i]) << " instead of " << values[i] << std::endl;
+        }
+    }
+
+    column.push_back(column[0]);
+    if (column.size() == values.size() + 1 && column[values.size()] == values[0])
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "Column push_back test failed: appending " << values[0] << " from the column itself gave "
+                  << bigint(column[column.size() - 1]) << std::endl;
+    }
+
+    column.clear();
+    if (column.empty() && column.limb_count() == 0)
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "Column clear test failed: " << column.size() << " values in " << column.limb_count() << " limbs left"
+                  << std::endl;
+    }
+
+    for (std::string bad : {"1\n\n2", "12a", "-", "1,2"})
+    {
+        try
+        {
+            bigint_column::parse(bad);
+            fail++;
+            std::cout << "Column parse test failed: exception not thrown for \"" << bad << "\"!" << std::endl;
+        }
+        catch (const std::invalid_argument &e)
+        {
+            std::cerr << "Exception caught: " << e.what() << std::endl;
+            pass++;
+        }
+    }
+    try
+    {
+        (void)(sum + column);
+        fail++;
+        std::cout << "Column arithmetic test failed: exception not thrown for columns of " << sum.size() << " and "
+                  << column.size() << " values!" << std::endl;
+    }
+    catch (const std::invalid_argument &e)
+    {
+        std::cerr << "Exception caught: " << e.what() << std::endl;
+        pass++;
+    }
+    try
+    {
+        (void)sum.at(values.size());
+        fail++;
+        std::cout << "Column at test failed: exception not thrown for index " << values.size() << "!" << std::endl;
+    }
+    catch (const std::out_of_range &e)
+    {
+        std::cerr << "Exception caught: " << e.what() << std::endl;
+        pass++;
+    }
+
+    // Output test results
+    if (fail == 0)
+    {
+        std::cout << "All column tests passed!" << std::endl;
+    }
+    else
+    {
+        std::cout << "Some column tests failed!" << std::endl;
+    }
+}
+
+/**
+ * @brief test the limb array functions against the bigint operators
+ *
+ */
+void mpn_test()
+{
+    // limb arrays of every length from 1 to above the small kernels, with all-ones limbs to force carries
+    std::mt19937_64 mt64(49);
+    auto random_limbs = [&](size_t n)
+    {
+        std::vector<bigint_limb> limbs(n);
+        for (bigint_limb &limb : limbs)
+        {
+            limb = mt64() % 4 == 0 ? ~bigint_limb(0) : mt64();
+        }
+        return limbs;
+    };
+    auto value = [](const std::vector<bigint_limb> &limbs, bigint_limb top = 0)
+    { return bigint(bigint_view(limbs)) + (bigint(1) << (64 * limbs.size())) * top; };
+    auto check = [](bool ok, const char *name, const bigint &actual, const bigint &expected, const bigint &a, const bigint &b)
+    {
+        if (ok)
+        {
+            pass++;
+        }
+        else
+        {
+            fail++;
+            std::cout << "Limb array test failed: " << name << " gave " << actual << " instead of " << expected << " for a = " << a
+                      << ", b = " << b << std::endl;
+        }
+    };
+
+    for (size_t n = 1; n <= 20; n++)
+    {
+        size_t m = mt64() % n + 1;
+        std::vector<bigint_limb> a = random_limbs(n), b = random_limbs(n), c = random_limbs(m), out(n), product(n + m);
+        bigint_limb limb = mt64();
+        bigint base = bigint(1) << (64 * n);
+        unsigned count = unsigned(mt64() % 63 + 1);
+        bigint expected;
+
+        // sums and differences, of equal lengths and of a shorter array added in place
+        bigint_limb carry = bigint_mpn_add_n(out.data(), a.data(), b.data(), n);
+        expected = value(a) + value(b);
+        check(value(out, carry) == expected, "bigint_mpn_add_n", value(out, carry), expected, value(a), value(b));
+        bigint_limb borrow = bigint_mpn_sub_n(out.data(), a.data(), b.data(), n);
+        expected = value(a) - value(b) + base * borrow;
+        check(value(out) == expected, "bigint_mpn_sub_n", value(out), expected, value(a), value(b));
+        out = a;
+        carry = bigint_mpn_add(out.data(), out.data(), n, c.data(), m);
+        expected = value(a) + value(c);
+        check(value(out, carry) == expected, "bigint_mpn_add", value(out, carry), expected, value(a), value(c));
+        borrow = bigint_mpn_sub(out.data(), a.data(), n, c.data(), m);
+        expected = value(a) - value(c) + base * borrow;
+        check(value(out) == expected, "bigint_mpn_sub", value(out), expected, value(a), value(c));
+
+        // products by one limb and long multiplication
+        out = a;
+        carry = bigint_mpn_addmul_1(out.data(), b.data(), n, limb);
+        expected = value(a) + value(b) * limb;
+        check(value(out, carry) == expected, "bigint_mpn_addmul_1", value(out, carry), expected, value(a), value(b));
+        out = a;
+        borrow = bigint_mpn_submul_1(out.data(), b.data(), n, limb);
+        expected = value(a) - value(b) * limb + base * borrow;
+        check(value(out) == expected, "bigint_mpn_submul_1", value(out), expected, value(a), value(b));
+        bigint_mpn_mul_basecase(product.data(), a.data(), n, c.data(), m);
+        expected = value(a) * value(c);
+        check(value(product) == expected, "bigint_mpn_mul_basecase", value(product), expected, value(a), value(c));
+
+        // comparison, and shifts in place with the bits shifted out returned
+        int order = bigint_mpn_cmp(a.data(), b.data(), n);
+        check(order == (value(a) < value(b) ? -1 : 1) && bigint_mpn_cmp(a.data(), a.data(), n) == 0, "bigint_mpn_cmp", order,
+              value(a) < value(b) ? -1 : 1, value(a), value(b));
+        out = a;
+        bigint_limb high = bigint_mpn_lshift(out.data(), out.data(), n, count);
+        expected = value(a) << count;
+        check(value(out, high) == expected, "bigint_mpn_lshift", value(out, high), expected, value(a), count);
+        bigint_limb low = bigint_mpn_rshift(out.data(), a.data(), n, count);
+        expected = value(a) >> count;
+        check(value(out) == expected && value(a) % (bigint(1) << count) << (64 - count) == value({low}), "bigint_mpn_rshift",
+              value(out), expected, value(a), count);
+    }
+
+    // the functions themselves allocate nothing, only the bigints made to check them do
+    bigint_limb x[] = {~bigint_limb(0), ~bigint_limb(0), 5}, y[] = {1};
+    bigint_stats_reset();
+    bigint_limb carry = bigint_mpn_add(x, x, 3, y, 1);
+    bigint_stats stats = bigint_stats_snapshot();
+    if (carry == 0 && x[0] == 0 && x[1] == 0 && x[2] == 6)
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "Limb array test failed: adding 1 to {2^64 - 1, 2^64 - 1, 5} gave {" << x[0] << ", " << x[1] << ", " << x[2]
+                  << "} and carry " << carry << std::endl;
+    }
+
+    if (stats.allocations == 0)
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "Limb array test failed: bigint_mpn_add allocated, counters were:\n" << stats << std::endl;
+    }
+
+    // Output test results
+    if (fail == 0)
+    {
+        std::cout << "All limb array tests passed!" << std::endl;
+    }
+    else
+    {
+        std::cout << "Some limb array tests failed!" << std::endl;
+    }
+}
+
+/**
+ * @brief test the instrumentation counters, compile with -DBIGINT_INSTRUMENTATION to enable them
+ *
+ */
+void stats_test()
+{
+    bigint a("123456789");
+    bigint b(987654321);
+    bigint_stats_reset();
+    bigint c = a * b;
+    bool smaller = a < c;
+    bigint_stats stats = bigint_stats_snapshot();
+
+    if (smaller)
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "Instrumentation test failed: " << a << " < " << c << " is false" << std::endl;
+    }
+
+#ifdef BIGINT_INSTRUMENTATION
+    if (stats[bigint_op::multiply].calls == 1 && stats[bigint_op::add].calls == 0 && stats[bigint_op::compare].calls == 1)
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "Instrumentation test failed: one multiply and one compare were not counted, counters were:\n"
+                  << stats << std::endl;
+    }
+
+    if (stats.allocations == 1 && stats.bytes_allocated == 2 * sizeof(bigint_limb)) // only the product buffer
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "Instrumentation test failed: " << stats.allocations << " allocations of " << stats.bytes_allocated
+                  << " bytes instead of 1 of " << 2 * sizeof(bigint_limb) << std::endl;
+    }
+
+    if (stats.selections(bigint_algorithm::mul_schoolbook) == 1 &&
+        stats.algorithms[size_t(bigint_algorithm::mul_schoolbook)][1] == 1) // 1 limb, in [1, 2)
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "Instrumentation test failed: a 1-limb schoolbook multiplication was not recorded, counters were:\n"
+                  << stats << std::endl;
+    }
+#else
+    if (stats[bigint_op::multiply].calls == 0 && stats.allocations == 0) // compiled out
+    {
+        pass++;
+    }
+    else
+    {
+        fail++;
+        std::cout << "Instrumentation test failed: counters changed with instrumentation compiled out, counters were:\n"
+                  << stats << std::endl;
+    }
+#endif
+
+    // Output test results
+    if (fail == 0)
+    {
+        std::cout << "All instrumentation tests passed!" << std::endl;
+    }
+    else
+    {
+        std::cout << "Some instrumentation tests failed!" << std::endl;
+    }
+}
+
 int main()
 {
 
@@ -572,6 +3115,29 @@ int main()
     increment_test();
     comparison_test();
     large_number_test();
+    view_test();
+    fixed_bigint_test();
+    literal_test();
+    bitwise_test();
+    native_test();
+    pow_test();
+    radix_test();
+    prime_test();
+    multiplication_test();
+    fma_test();
+    rns_test();
+    digits_test();
+    kernels_test();
+    shared_test();
+    batch_test();
+    thresholds_test();
+    small_kernels_test();
+    power_radix_test();
+    parallel_test();
+    scratch_test();
+    column_test();
+    mpn_test();
+    stats_test();
 
     if (fail == 0)
     {
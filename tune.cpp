@@ -0,0 +1,124 @@
+/**
+ * @file tune.cpp
+ * @author Shihong Cong
+ * @brief Measures the bigint algorithm thresholds on this machine and saves them as a config file or header
+ * @version 0.1
+ * @date 2024-12-29
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "bigint_tune.hpp"
+
+/**
+ * @brief command line options of the tuning tool
+ *
+ */
+struct tune_command
+{
+    bigint_tune_options options; // how long and how far to measure
+    std::string config_path;     // where to write a file for BIGINT_THRESHOLDS, empty means nowhere
+    std::string header_path;     // where to write bigint_tuned.hpp, empty means nowhere
+    bool quiet = false;          // true to print only the results
+};
+
+/**
+ * @brief parse the command line
+ *
+ * @param argc the number of arguments
+ * @param argv the arguments
+ * @return tune_command the options, throws std::invalid_argument on an unknown option
+ */
+tune_command parse_command(int argc, char *argv[])
+{
+    tune_command command;
+    std::vector<std::string> args(argv + 1, argv + argc);
+    for (size_t i = 0; i < args.size(); i++)
+    {
+        auto value = [&]() -> const std::string &
+        {
+            if (i + 1 >= args.size())
+            {
+                throw std::invalid_argument("Missing value for " + args[i]);
+            }
+            return args[++i];
+        };
+
+        if (args[i] == "--min-time")
+        {
+            command.options.min_time = std::stod(value());
+        }
+        else if (args[i] == "--max-limbs")
+        {
+            command.options.max_limbs = std::stoull(value());
+        }
+        else if (args[i] == "--config")
+        {
+            command.config_path = value();
+        }
+        else if (args[i] == "--header")
+        {
+            command.header_path = value();
+        }
+        else if (args[i] == "--quiet")
+        {
+            command.quiet = true;
+        }
+        else
+        {
+            throw std::invalid_argument("Unknown option: " + args[i] +
+                                        "\nUsage: tune [--min-time S] [--max-limbs N] [--config FILE] [--header FILE] [--quiet]");
+        }
+    }
+    return command;
+}
+
+int main(int argc, char *argv[])
+{
+    tune_command command;
+    try
+    {
+        command = parse_command(argc, argv);
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 2;
+    }
+
+    if (!command.quiet)
+    {
+        command.options.log = &std::cout;
+        std::cout << "kernels: " << bigint_active_kernels.name << "\n\n";
+    }
+    bigint_thresholds tuned = bigint_tune(command.options);
+
+    std::cout << "\nmeasured thresholds, in limbs:\n";
+    tuned.save(std::cout);
+    if (!command.config_path.empty())
+    {
+        std::ofstream config(command.config_path);
+        tuned.save(config);
+        if (!config)
+        {
+            std::cerr << "Cannot write " << command.config_path << std::endl;
+            return 1;
+        }
+    }
+    if (!command.header_path.empty())
+    {
+        std::ofstream header(command.header_path);
+        tuned.save_header(header);
+        if (!header)
+        {
+            std::cerr << "Cannot write " << command.header_path << std::endl;
+            return 1;
+        }
+    }
+    return 0;
+}